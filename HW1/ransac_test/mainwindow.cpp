@@ -48,17 +48,51 @@ y값 분포 분석:
 */
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "csv_loader.h"
+#include "embedded_dataset.h"
+#if VISION_HAVE_EMBEDDED_DATA
+#include "embedded_coordinates.h"
+#endif
 #include <QFile>
-#include <QTextStream>
-#include <QGraphicsEllipseItem>
+#include <QFileSystemWatcher>
+#include <QGraphicsItem>
 #include <QPen>
 #include <QDebug>
-#include <cmath>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QStringList>
+#include <QtConcurrent/QtConcurrentRun>
 
-MainWindow::MainWindow(QWidget *parent)
+namespace {
+
+// 기본 데이터 (qrc)
+const char defaultDataFile[] = ":/resources/data/coordinates.csv";
+
+// 빌드할 때 미리 파싱해 둔 기본 데이터. 만들지 못한 빌드(크로스 컴파일)면
+// nullptr 이고 qrc 의 CSV 를 파싱한다.
+const vision::EmbeddedDataset *embeddedData(const QString &fileName)
+{
+#if VISION_HAVE_EMBEDDED_DATA
+    if (fileName == defaultDataFile) {
+        return &vision::embedded::coordinates;
+    }
+#else
+    Q_UNUSED(fileName);
+#endif
+    return nullptr;
+}
+
+// RANSAC 파라미터 설정
+const int ransacIterations = 1000;       // 고정된 반복 횟수
+const double ransacThreshold = 200.0;    // inlier로 판단할 최대 거리
+
+} // namespace
+
+MainWindow::MainWindow(QWidget *parent, const QString &followFile)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , scene(new QGraphicsScene(this))
+    , fileWatcher(new QFileSystemWatcher(this))
 {
     ui->setupUi(this);
 
@@ -68,12 +102,33 @@ MainWindow::MainWindow(QWidget *parent)
     ui->graphicsView->scale(-1, -1);
     ui->graphicsView->setSceneRect(-100, -2500, 200, 5000);
 
+    // 진행률 표시와 취소 버튼 (작업 중에만 보임)
+    progressBar = new QProgressBar(this);
+    progressBar->setRange(0, 100);
+    progressBar->setMaximumWidth(200);
+    cancelButton = new QPushButton(tr("취소"), this);
+    ui->statusbar->addPermanentWidget(progressBar);
+    ui->statusbar->addPermanentWidget(cancelButton);
+    progressBar->hide();
+    cancelButton->hide();
+
+    connect(cancelButton, &QPushButton::clicked, this, &MainWindow::cancelLoad);
+    connect(&loadWatcher, &QFutureWatcher<LoadResult>::finished, this, &MainWindow::onLoadFinished);
+    connect(fileWatcher, &QFileSystemWatcher::fileChanged, this, &MainWindow::onFollowedFileChanged);
+
     drawAxes();
-    loadCSVData(":/resources/data/coordinates.csv");
+    if (followFile.isEmpty()) {
+        loadCSVData(defaultDataFile);
+    } else {
+        startFollow(followFile);
+    }
 }
 
 MainWindow::~MainWindow()
 {
+    // 작업 스레드가 this 를 참조하지 않도록 끝날 때까지 기다린다
+    cancelLoad();
+    loadWatcher.waitForFinished();
     delete ui;
 }
 
@@ -88,169 +143,280 @@ void MainWindow::drawAxes()
 
 void MainWindow::loadCSVData(const QString &fileName)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Cannot open file for reading:" << file.errorString();
-        return;
+    // 이전 작업이 남아 있으면 취소
+    cancelLoad();
+    loadWatcher.waitForFinished();
+
+    auto control = std::make_shared<vision::JobControl>([this](double fraction) {
+        QMetaObject::invokeMethod(this, [this, fraction] { onLoadProgress(fraction); },
+                                  Qt::QueuedConnection);
+    });
+    loadControl = control;
+
+    progressBar->setValue(0);
+    progressBar->show();
+    cancelButton->show();
+    ui->statusbar->showMessage(tr("RANSAC 계산 중..."));
+
+    loadWatcher.setFuture(QtConcurrent::run([fileName, control] {
+        return runLoad(fileName, control.get());
+    }));
+}
+
+void MainWindow::cancelLoad()
+{
+    if (loadControl) {
+        loadControl->cancel();
     }
+}
 
-    QTextStream in(&file);
-    QString headerLine = in.readLine();  // 헤더 스킵
+void MainWindow::onLoadProgress(double fraction)
+{
+    progressBar->setValue(static_cast<int>(fraction * 100));
+}
 
-    QPen pointPen(Qt::blue);
-    QBrush pointBrush(Qt::blue);
+MainWindow::LoadResult MainWindow::runLoad(const QString &fileName, vision::JobControl *control)
+{
+    LoadResult result;
 
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        QStringList values = line.split(",");
+    // 헤더 스킵 후 x, y 두 열만 있는 행을 읽는다 (전체 진행률의 30%)
+    if (const vision::EmbeddedDataset *embedded = embeddedData(fileName)) {
+        embedded->copyTo(result.points);  // 빌드할 때 파싱한 배열을 복사만
+        result.csv = embedded->csvStats();
+    } else {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            result.error = file.errorString();
+            return result;
+        }
 
-        if (values.size() == 2) {
-            bool okX, okY;
-            double x = values[0].toDouble(&okX);
-            double y = values[1].toDouble(&okY);
+        // 파일을 매핑해서 복사 없이 파싱. 압축된 qrc 리소스처럼 매핑이 안 되면 readAll
+        QByteArray buffer;
+        const char *data = reinterpret_cast<const char *>(file.map(0, file.size()));
+        std::size_t size = static_cast<std::size_t>(file.size());
+        if (!data) {
+            buffer = file.readAll();
+            data = buffer.constData();
+            size = static_cast<std::size_t>(buffer.size());
+        }
 
-            if (okX && okY) {
-                double scaled_x = -(x * 2);
-                points.append(QPointF(scaled_x, y));
+        control->setProgressRange(0.0, 0.3);
+        result.csv = vision::parseCsv(data, size, vision::CsvOptions(), result.points, control,
+                                      &result.stats);
+    }
 
-                QGraphicsEllipseItem *pointItem =
-                    new QGraphicsEllipseItem(scaled_x - 2, y - 2, 4, 4);
-                pointItem->setPen(pointPen);
-                pointItem->setBrush(pointBrush);
-                scene->addItem(pointItem);
-            }
+    vision::PointSet &points = result.points;
+    {
+        vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+        result.pointPath.setFillRule(Qt::WindingFill);
+        for (std::size_t i = 0; i < points.size(); i++) {
+            double scaled_x = -(points.x[i] * 2);
+            points.x[i] = scaled_x;
+            result.pointPath.addEllipse(scaled_x - 2, points.y[i] - 2, 4, 4);
         }
     }
 
-    // RANSAC 파라미터 설정
-    const int iterations = 1000;         // 고정된 반복 횟수
-    const double threshold = 200.0;      // inlier로 판단할 최대 거리
+    vision::RansacParams params;
+    params.iterations = ransacIterations;
+    params.threshold = ransacThreshold;
+    params.threads = 0;  // 가설을 모든 코어로 나눠 평가 (결과는 스레드 수와 무관)
 
-    ModelParameters bestModel = ransac(points, iterations, threshold);
+    control->setProgressRange(0.3, 1.0);
+    result.model = vision::ransac(points.view(), params, control, &result.stats);
+    result.cancelled = control->isCancelled();
 
-    // 결과 출력
-    qDebug() << "RANSAC Parameters:";
-    qDebug() << "Iterations:" << iterations;
-    qDebug() << "Distance Threshold:" << threshold;
-    qDebug() << "\nBest model parameters:";
-    qDebug() << "a:" << bestModel.a;
-    qDebug() << "b:" << bestModel.b;
-    qDebug() << "Number of inliers:" << bestModel.inliers.size();
-
-    // 모델 그리기
-    drawModel(bestModel, Qt::red);
+    // 인라이어 점들
+    vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+    result.inlierPath.setFillRule(Qt::WindingFill);
+    for (std::size_t idx : result.model.inliers) {
+        result.inlierPath.addEllipse(points.x[idx] - 2, points.y[idx] - 2, 4, 4);
+    }
 
-    file.close();
+    return result;
 }
 
-MainWindow::ModelParameters MainWindow::ransac(const QVector<QPointF>& points,
-                                             int iterations,
-                                             double threshold)
+void MainWindow::onLoadFinished()
 {
-    ModelParameters bestModel;
-    bestModel.a = 0;
-    bestModel.b = 0;
-    int maxInliers = 0;
-
-    QRandomGenerator generator;
+    progressBar->hide();
+    cancelButton->hide();
 
-    for(int iter = 0; iter < iterations; iter++) {
-        if(points.size() < 2) continue;
-
-        // 1. 무작위로 2개의 점 선택
-        int idx1 = generator.bounded(points.size());
-        int idx2 = generator.bounded(points.size());
+    LoadResult result = loadWatcher.result();
+    if (!result.error.isEmpty()) {
+        qWarning() << "Cannot open file for reading:" << result.error;
+        ui->statusbar->showMessage(result.error);
+        return;
+    }
+    if (result.cancelled) {
+        ui->statusbar->showMessage(tr("취소됨"));
+        return;
+    }
+    reportRejectedRows(result.csv);
 
-        if(idx1 == idx2) continue;
+    points = std::move(result.points);
+    {
+        vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+        scene->addPath(result.pointPath, QPen(Qt::blue), QBrush(Qt::blue));
+    }
 
-        QPointF p1 = points[idx1];
-        QPointF p2 = points[idx2];
+    // 결과 출력
+    const vision::RansacResult &bestModel = result.model;
+    qDebug() << "RANSAC Parameters:";
+    qDebug() << "Iterations:" << ransacIterations;
+    qDebug() << "Distance Threshold:" << ransacThreshold;
+    qDebug() << "\nBest model parameters:";
+    qDebug() << "a:" << bestModel.model.a;
+    qDebug() << "b:" << bestModel.model.b;
+    qDebug() << "Number of inliers:" << bestModel.inliers.size();
+    qDebug() << "Achieved confidence:" << bestModel.confidence;  // 1 - (1 - w^2)^N
 
-        // 수직선 방지
-        if(std::abs(p2.x() - p1.x()) < 0.0001) continue;
+    // 모델 그리기
+    {
+        vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+        drawModel(result, Qt::red);
+    }
+    showStats(QString("a: %1  b: %2  inliers: %3 / %4")
+                  .arg(bestModel.model.a)
+                  .arg(bestModel.model.b)
+                  .arg(bestModel.inliers.size())
+                  .arg(points.size()),
+              result.stats);
+}
 
-        // 2. 모델 파라미터 계산 (a, b)
-        double a = (p2.y() - p1.y()) / (p2.x() - p1.x());
-        double b = p1.y() - a * p1.x();
+void MainWindow::reportRejectedRows(const vision::CsvStats &csv)
+{
+    // 건너뛴 행을 조용히 버리지 않고 줄 번호와 함께 알린다
+    if (csv.rejectedRows == 0) return;
 
-        // 3. 인라이어 찾기
-        QVector<QPointF> currentInliers;
+    QStringList lines;
+    for (std::size_t line : csv.rejectedLines) {
+        lines << QString::number(line);
+    }
+    if (csv.rejectedRows > csv.rejectedLines.size()) {
+        lines << "...";
+    }
+    qWarning().noquote() << QString("Skipped %1 of %2 rows (line %3)")
+                                .arg(csv.rejectedRows)
+                                .arg(csv.rows)
+                                .arg(lines.join(", "));
+}
 
-        for(const QPointF& point : points) {
-            double distance = computeDistance(point, a, b);
-            if(distance < threshold) {
-                currentInliers.append(point);
-            }
-        }
+void MainWindow::startFollow(const QString &fileName)
+{
+    vision::RansacParams params;
+    params.iterations = ransacIterations;
+    params.threshold = ransacThreshold;
+
+    followedFile = fileName;
+    tail.open(QFile::encodeName(fileName).toStdString());
+    points.clear();
+    followedRansac = vision::IncrementalRansac(params);
+
+    scene->clear();
+    followedLine = nullptr;
+    followedInlierItems.clear();
+    drawnInliers = 0;
+    drawAxes();
 
-        // 4. 현재 모델의 인라이어가 더 많으면 업데이트
-        if(currentInliers.size() > maxInliers) {
-            maxInliers = currentInliers.size();
-            ModelParameters refinedModel = fitLine(currentInliers);
-            bestModel = refinedModel;
-            bestModel.inliers = currentInliers;
-        }
+    if (!fileWatcher->files().contains(fileName)) {
+        fileWatcher->addPath(fileName);
     }
-
-    return bestModel;
+    onFollowedFileChanged();
 }
 
-MainWindow::ModelParameters MainWindow::fitLine(const QVector<QPointF>& points)
+void MainWindow::onFollowedFileChanged()
 {
-    ModelParameters model;
-    if(points.isEmpty()) {
-        model.a = 0;
-        model.b = 0;
-        return model;
+    // 파일을 새로 만들어 바꿔치기하는 프로그램이면 감시가 풀리므로 다시 등록
+    if (!fileWatcher->files().contains(followedFile) && QFile::exists(followedFile)) {
+        fileWatcher->addPath(followedFile);
     }
 
-    double sumX = 0, sumY = 0, sumXY = 0, sumX2 = 0;
-    int n = points.size();
+    // 추가된 바이트만 파싱
+    vision::Stats stats;
+    const std::size_t first = points.size();
+    std::string error;
+    vision::CsvTail::PollStatus status;
+    {
+        vision::ScopedTimer timer(&stats, vision::Stage::Parse);
+        status = tail.poll(points, &error);
+    }
+    if (status == vision::CsvTail::PollStatus::Truncated) {
+        startFollow(followedFile);  // 잘리거나 교체됨: 처음부터 다시
+        return;
+    }
+    if (status == vision::CsvTail::PollStatus::Error) {
+        ui->statusbar->showMessage(QString::fromStdString(error));
+        return;
+    }
+    if (points.size() == first) {
+        return;
+    }
 
-    for(const QPointF& point : points) {
-        sumX += point.x();
-        sumY += point.y();
-        sumXY += point.x() * point.y();
-        sumX2 += point.x() * point.x();
+    // 새 점만 스케일 조정하고 그린다
+    QPainterPath pointPath;
+    pointPath.setFillRule(Qt::WindingFill);
+    for (std::size_t i = first; i < points.size(); i++) {
+        double scaled_x = -(points.x[i] * 2);
+        points.x[i] = scaled_x;
+        pointPath.addEllipse(scaled_x - 2, points.y[i] - 2, 4, 4);
     }
 
-    if(std::abs(n * sumX2 - sumX * sumX) < 0.0001) {
-        model.a = 0;
-        model.b = sumY / n;
-    } else {
-        model.a = (n * sumXY - sumX * sumY) / (n * sumX2 - sumX * sumX);
-        model.b = (sumY - model.a * sumX) / n;
+    // 새 점 판정 + 새 점으로 만든 가설 몇 개만 평가
+    const bool replaced = followedRansac.update(points.view(), &stats);
+    const vision::RansacResult &bestModel = followedRansac.result();
+
+    vision::ScopedTimer timer(&stats, vision::Stage::Scene);
+    scene->addPath(pointPath, QPen(Qt::blue), QBrush(Qt::blue));
+
+    // 가설이 바뀌었으면 inlier 를 모두 다시, 아니면 새 inlier 만 그린다
+    if (replaced) {
+        qDeleteAll(followedInlierItems);
+        followedInlierItems.clear();
+        drawnInliers = 0;
+    }
+    QPainterPath inlierPath;
+    inlierPath.setFillRule(Qt::WindingFill);
+    for (std::size_t i = drawnInliers; i < bestModel.inliers.size(); i++) {
+        const std::size_t idx = bestModel.inliers[i];
+        inlierPath.addEllipse(points.x[idx] - 2, points.y[idx] - 2, 4, 4);
     }
+    drawnInliers = bestModel.inliers.size();
+    followedInlierItems.append(scene->addPath(inlierPath, QPen(Qt::green), QBrush(Qt::green)));
 
-    return model;
+    // 모델 선
+    delete followedLine;
+    QPen modelPen(Qt::red);
+    modelPen.setWidth(2);
+    followedLine = scene->addLine(0, bestModel.model.b,
+                                  -100, bestModel.model.a * -100 + bestModel.model.b, modelPen);
+
+    showStats(QString("a: %1  b: %2  inliers: %3 / %4 (+%5)")
+                  .arg(bestModel.model.a)
+                  .arg(bestModel.model.b)
+                  .arg(bestModel.inliers.size())
+                  .arg(points.size())
+                  .arg(points.size() - first),
+              stats);
 }
 
-double MainWindow::computeDistance(const QPointF& point, double a, double b)
+void MainWindow::showStats(const QString &message, const vision::Stats &stats)
 {
-    return std::abs(a * point.x() - point.y() + b) / std::sqrt(a * a + 1);
+    // 상태 표시줄에는 요약, 전체는 JSON 으로 디버그 출력
+    qDebug().noquote() << "Stats:" << QString::fromStdString(stats.toJson());
+    ui->statusbar->showMessage(message + "  |  " + QString::fromStdString(stats.summary()));
 }
 
-void MainWindow::drawModel(const ModelParameters& model, const QColor& color)
+void MainWindow::drawModel(const LoadResult& result, const QColor& color)
 {
     // 모델 선 그리기
     double x1 = 0;
     double x2 = -100;
-    double y1 = model.a * x1 + model.b;
-    double y2 = model.a * x2 + model.b;
+    double y1 = result.model.model.a * x1 + result.model.model.b;
+    double y2 = result.model.model.a * x2 + result.model.model.b;
 
     QPen modelPen(color);
     modelPen.setWidth(2);
     scene->addLine(x1, y1, x2, y2, modelPen);
 
     // 인라이어 점들 표시
-    QPen inlierPen(Qt::green);
-    QBrush inlierBrush(Qt::green);
-
-    for(const QPointF& point : model.inliers) {
-        QGraphicsEllipseItem *pointItem =
-            new QGraphicsEllipseItem(point.x() - 2, point.y() - 2, 4, 4);
-        pointItem->setPen(inlierPen);
-        pointItem->setBrush(inlierBrush);
-        scene->addItem(pointItem);
-    }
+    scene->addPath(result.inlierPath, QPen(Qt::green), QBrush(Qt::green));
 }
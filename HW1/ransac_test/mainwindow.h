@@ -3,9 +3,24 @@
 
 #include <QMainWindow>
 #include <QGraphicsScene>
-#include <QPointF>
-#include <QVector>
-#include <QRandomGenerator>
+#include <QFutureWatcher>
+#include <QPainterPath>
+#include <QList>
+#include <QString>
+#include <memory>
+
+#include "csv_loader.h"
+#include "csv_tail.h"
+#include "incremental.h"
+#include "job_control.h"
+#include "stats.h"
+#include "point_set.h"
+#include "ransac.h"
+
+class QFileSystemWatcher;
+class QGraphicsItem;
+class QProgressBar;
+class QPushButton;
 
 namespace Ui {
 class MainWindow;
@@ -16,32 +31,58 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget *parent = nullptr);
+    // followFile 을 주면 내장 데이터 대신 그 파일을 읽고, 이후 뒤에 추가되는
+    // 행만 읽어서 모델을 갱신한다 (팔로우 모드)
+    explicit MainWindow(QWidget *parent = nullptr, const QString &followFile = QString());
     ~MainWindow();
 
 private:
-    // ModelParameters 구조체
-    struct ModelParameters {
-        double a;  // 기울기
-        double b;  // y절편
-        QVector<QPointF> inliers;  // inlier 점들
+    // 작업 스레드에서 만들어 GUI 스레드로 넘기는 결과
+    struct LoadResult {
+        vision::PointSet points;
+        vision::RansacResult model;
+        QPainterPath pointPath;   // 점마다 아이템을 만들지 않고 path 하나로 그린다
+        QPainterPath inlierPath;
+        vision::Stats stats;     // 단계별 시간과 카운터
+        vision::CsvStats csv;    // 행 수와 잘못된 행의 줄 번호
+        QString error;
+        bool cancelled = false;
     };
 
     Ui::MainWindow *ui;
     QGraphicsScene *scene;
-    QVector<QPointF> points;
+    vision::PointSet points;
+
+    // 백그라운드 작업
+    QFutureWatcher<LoadResult> loadWatcher;
+    std::shared_ptr<vision::JobControl> loadControl;
+    QProgressBar *progressBar;
+    QPushButton *cancelButton;
+
+    // 팔로우 모드 (GUI 스레드에서 새 행만 처리)
+    QFileSystemWatcher *fileWatcher;
+    QString followedFile;
+    vision::CsvTail tail;
+    vision::IncrementalRansac followedRansac;
+    QGraphicsItem *followedLine = nullptr;
+    QList<QGraphicsItem *> followedInlierItems;  // 가설이 바뀌면 모두 지우고 다시 그린다
+    std::size_t drawnInliers = 0;
 
     void drawAxes();
-    void loadCSVData(const QString &fileName);
+    void loadCSVData(const QString &fileName);  // 파싱 + RANSAC 을 백그라운드로 시작
+    void cancelLoad();
+    void onLoadProgress(double fraction);
+    void onLoadFinished();
+    void showStats(const QString &message, const vision::Stats &stats);
+    void reportRejectedRows(const vision::CsvStats &csv);
+    void startFollow(const QString &fileName);
+    void onFollowedFileChanged();
 
-    // RANSAC 관련 함수들
-    ModelParameters ransac(const QVector<QPointF>& points,
-                         int iterations = 500,        // 고정된 반복 횟수
-                         double threshold = 50.0);    // inlier 판단 거리
+    // 작업 스레드에서 실행 (scene 에 접근하지 않음)
+    static LoadResult runLoad(const QString &fileName, vision::JobControl *control);
 
-    ModelParameters fitLine(const QVector<QPointF>& points);
-    double computeDistance(const QPointF& point, double a, double b);
-    void drawModel(const ModelParameters& model, const QColor& color);
+    // RANSAC 자체는 vision_core 에 있다 (vision::ransac)
+    void drawModel(const LoadResult& result, const QColor& color);
 };
 
 #endif // MAINWINDOW_H
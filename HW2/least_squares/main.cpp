@@ -1,11 +1,15 @@
 #include "mainwindow.h"
 
 #include <QApplication>
+#include <QStringList>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
-    MainWindow w;
+
+    // CSV 경로를 인자로 주면 그 파일을 따라가며 갱신 (팔로우 모드)
+    const QStringList arguments = a.arguments();
+    MainWindow w(nullptr, arguments.size() > 1 ? arguments.at(1) : QString());
     w.show();
     return a.exec();
 }
@@ -5,17 +5,47 @@ b: 296.489
 */
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "csv_loader.h"
+#include "embedded_dataset.h"
+#if VISION_HAVE_EMBEDDED_DATA
+#include "embedded_coordinates.h"
+#endif
 #include <QFile>
-#include <QTextStream>
-#include <QGraphicsEllipseItem>
+#include <QFileSystemWatcher>
+#include <QGraphicsLineItem>
 #include <QPen>
 #include <QDebug>
-#include <cmath>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QStringList>
+#include <QtConcurrent/QtConcurrentRun>
 
-MainWindow::MainWindow(QWidget *parent)
+namespace {
+
+// 기본 데이터 (qrc)
+const char defaultDataFile[] = ":/resources/data/coordinates.csv";
+
+// 빌드할 때 미리 파싱해 둔 기본 데이터. 만들지 못한 빌드(크로스 컴파일)면
+// nullptr 이고 qrc 의 CSV 를 파싱한다.
+const vision::EmbeddedDataset *embeddedData(const QString &fileName)
+{
+#if VISION_HAVE_EMBEDDED_DATA
+    if (fileName == defaultDataFile) {
+        return &vision::embedded::coordinates;
+    }
+#else
+    Q_UNUSED(fileName);
+#endif
+    return nullptr;
+}
+
+} // namespace
+
+MainWindow::MainWindow(QWidget *parent, const QString &followFile)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , scene(new QGraphicsScene(this))
+    , fileWatcher(new QFileSystemWatcher(this))
 {
     ui->setupUi(this);
 
@@ -27,12 +57,33 @@ MainWindow::MainWindow(QWidget *parent)
     ui->graphicsView->scale(-1, -1);
     ui->graphicsView->setSceneRect(-100, -2500, 200, 5000);
 
+    // 진행률 표시와 취소 버튼 (작업 중에만 보임)
+    progressBar = new QProgressBar(this);
+    progressBar->setRange(0, 100);
+    progressBar->setMaximumWidth(200);
+    cancelButton = new QPushButton(tr("취소"), this);
+    ui->statusbar->addPermanentWidget(progressBar);
+    ui->statusbar->addPermanentWidget(cancelButton);
+    progressBar->hide();
+    cancelButton->hide();
+
+    connect(cancelButton, &QPushButton::clicked, this, &MainWindow::cancelLoad);
+    connect(&loadWatcher, &QFutureWatcher<LoadResult>::finished, this, &MainWindow::onLoadFinished);
+    connect(fileWatcher, &QFileSystemWatcher::fileChanged, this, &MainWindow::onFollowedFileChanged);
+
     drawAxes();
-    loadCSVData(":/resources/data/coordinates.csv");
+    if (followFile.isEmpty()) {
+        loadCSVData(defaultDataFile);
+    } else {
+        startFollow(followFile);
+    }
 }
 
 MainWindow::~MainWindow()
 {
+    // 작업 스레드가 this 를 참조하지 않도록 끝날 때까지 기다린다
+    cancelLoad();
+    loadWatcher.waitForFinished();
     delete ui;
 }
 
@@ -49,115 +100,239 @@ void MainWindow::drawAxes()
 
 void MainWindow::loadCSVData(const QString &fileName)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Cannot open file for reading:" << file.errorString();
-        return;
-    }
+    // 이전 작업이 남아 있으면 취소
+    cancelLoad();
+    loadWatcher.waitForFinished();
+
+    auto control = std::make_shared<vision::JobControl>([this](double fraction) {
+        QMetaObject::invokeMethod(this, [this, fraction] { onLoadProgress(fraction); },
+                                  Qt::QueuedConnection);
+    });
+    loadControl = control;
+
+    progressBar->setValue(0);
+    progressBar->show();
+    cancelButton->show();
+    ui->statusbar->showMessage(tr("최소제곱법 계산 중..."));
+
+    loadWatcher.setFuture(QtConcurrent::run([fileName, control] {
+        return runLoad(fileName, control.get());
+    }));
+}
 
-    QTextStream in(&file);
-    QString headerLine = in.readLine();  // 헤더 스킵
+void MainWindow::cancelLoad()
+{
+    if (loadControl) {
+        loadControl->cancel();
+    }
+}
 
-    // 점 스타일 설정
-    QPen pointPen(Qt::blue);
-    QBrush pointBrush(Qt::blue);
+void MainWindow::onLoadProgress(double fraction)
+{
+    progressBar->setValue(static_cast<int>(fraction * 100));
+}
 
-    QVector<QPointF> points;  // 데이터 포인트를 저장할 벡터
+MainWindow::LoadResult MainWindow::runLoad(const QString &fileName, vision::JobControl *control)
+{
+    LoadResult result;
 
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        QStringList values = line.split(",");
+    // 데이터 포인트를 저장할 SoA 버퍼 (헤더 스킵, x, y 두 열)
+    vision::PointSet points;
+    if (const vision::EmbeddedDataset *embedded = embeddedData(fileName)) {
+        embedded->copyTo(points);  // 빌드할 때 파싱한 배열을 복사만
+        result.csv = embedded->csvStats();
+    } else {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            result.error = file.errorString();
+            return result;
+        }
 
-        if (values.size() == 2) {
-            bool okX, okY;
-            double x = values[0].toDouble(&okX);
-            double y = values[1].toDouble(&okY);
+        // 파일을 매핑해서 복사 없이 파싱. 압축된 qrc 리소스처럼 매핑이 안 되면 readAll
+        QByteArray buffer;
+        const char *data = reinterpret_cast<const char *>(file.map(0, file.size()));
+        std::size_t size = static_cast<std::size_t>(file.size());
+        if (!data) {
+            buffer = file.readAll();
+            data = buffer.constData();
+            size = static_cast<std::size_t>(buffer.size());
+        }
 
-            if (okX && okY) {
-                // x 값을 0~-100 범위로 스케일 조정
-                double scaled_x = -(x * 2);  // 음수로 변경하여 반전
+        result.csv = vision::parseCsv(data, size, vision::CsvOptions(), points, control,
+                                      &result.stats);
+    }
+    if (control->isCancelled()) {
+        result.cancelled = true;
+        return result;
+    }
 
-                points.append(QPointF(scaled_x, y));
+    {
+        vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+        result.pointPath.setFillRule(Qt::WindingFill);
+        for (std::size_t i = 0; i < points.size(); i++) {
+            // x 값을 0~-100 범위로 스케일 조정
+            double scaled_x = -(points.x[i] * 2);  // 음수로 변경하여 반전
+            points.x[i] = scaled_x;
 
-                // 점 그리기
-                QGraphicsEllipseItem *pointItem =
-                    new QGraphicsEllipseItem(scaled_x - 2, y - 2, 4, 4);
-                pointItem->setPen(pointPen);
-                pointItem->setBrush(pointBrush);
-                scene->addItem(pointItem);
-            }
+            // 점 그리기
+            result.pointPath.addEllipse(scaled_x - 2, points.y[i] - 2, 4, 4);
         }
     }
 
     // 최소제곱법으로 직선 모델 구하기
-    LineModel model = fitLineWithLeastSquares(points);
+    vision::ScopedTimer timer(&result.stats, vision::Stage::LeastSquares);
+    result.model = vision::fitLineLeastSquares(points.view());
+    result.totalError = vision::sumSquaredError(points.view(), result.model);
+    result.pointCount = points.size();
+
+    return result;
+}
+
+void MainWindow::onLoadFinished()
+{
+    progressBar->hide();
+    cancelButton->hide();
+
+    LoadResult result = loadWatcher.result();
+    if (!result.error.isEmpty()) {
+        qWarning() << "Cannot open file for reading:" << result.error;
+        ui->statusbar->showMessage(result.error);
+        return;
+    }
+    if (result.cancelled) {
+        ui->statusbar->showMessage(tr("취소됨"));
+        return;
+    }
+    reportRejectedRows(result.csv);
+
+    // 점 스타일 설정
+    {
+        vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+        scene->addPath(result.pointPath, QPen(Qt::blue), QBrush(Qt::blue));
+    }
 
     // 결과 출력
     qDebug() << "Linear regression parameters:";
-    qDebug() << "a:" << model.a;
-    qDebug() << "b:" << model.b;
+    qDebug() << "a:" << result.model.a;
+    qDebug() << "b:" << result.model.b;
 
     // 계산된 오차 제곱합 출력
-    double totalError = calculateError(points, model);
-    qDebug() << "Total squared error:" << totalError;
+    qDebug() << "Total squared error:" << result.totalError;
 
     // 모델 그리기
-    drawLine(model, Qt::red);
+    {
+        vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+        drawLine(result.model, Qt::red);
+    }
+    showStats(QString("a: %1  b: %2  points: %3")
+                  .arg(result.model.a)
+                  .arg(result.model.b)
+                  .arg(result.pointCount),
+              result.stats);
+}
+
+void MainWindow::reportRejectedRows(const vision::CsvStats &csv)
+{
+    // 건너뛴 행을 조용히 버리지 않고 줄 번호와 함께 알린다
+    if (csv.rejectedRows == 0) return;
 
-    file.close();
+    QStringList lines;
+    for (std::size_t line : csv.rejectedLines) {
+        lines << QString::number(line);
+    }
+    if (csv.rejectedRows > csv.rejectedLines.size()) {
+        lines << "...";
+    }
+    qWarning().noquote() << QString("Skipped %1 of %2 rows (line %3)")
+                                .arg(csv.rejectedRows)
+                                .arg(csv.rows)
+                                .arg(lines.join(", "));
 }
 
-MainWindow::LineModel MainWindow::fitLineWithLeastSquares(const QVector<QPointF>& points)
+void MainWindow::startFollow(const QString &fileName)
 {
-    LineModel model;
-    if (points.isEmpty()) {
-        model.a = 0;
-        model.b = 0;
-        return model;
+    followedFile = fileName;
+    tail.open(QFile::encodeName(fileName).toStdString());
+    followedPoints.clear();
+    followedFit.reset();
+
+    scene->clear();
+    followedLine = nullptr;
+    drawAxes();
+
+    if (!fileWatcher->files().contains(fileName)) {
+        fileWatcher->addPath(fileName);
     }
+    onFollowedFileChanged();
+}
 
-    // 평균 계산
-    double sumX = 0, sumY = 0;
-    double sumXY = 0, sumX2 = 0;
-    int n = points.size();
+void MainWindow::onFollowedFileChanged()
+{
+    // 파일을 새로 만들어 바꿔치기하는 프로그램이면 감시가 풀리므로 다시 등록
+    if (!fileWatcher->files().contains(followedFile) && QFile::exists(followedFile)) {
+        fileWatcher->addPath(followedFile);
+    }
 
-    for (const QPointF& point : points) {
-        sumX += point.x();
-        sumY += point.y();
-        sumXY += point.x() * point.y();
-        sumX2 += point.x() * point.x();
+    // 추가된 바이트만 파싱
+    vision::Stats stats;
+    const std::size_t first = followedPoints.size();
+    std::string error;
+    vision::CsvTail::PollStatus status;
+    {
+        vision::ScopedTimer timer(&stats, vision::Stage::Parse);
+        status = tail.poll(followedPoints, &error);
+    }
+    if (status == vision::CsvTail::PollStatus::Truncated) {
+        startFollow(followedFile);  // 잘리거나 교체됨: 처음부터 다시
+        return;
+    }
+    if (status == vision::CsvTail::PollStatus::Error) {
+        ui->statusbar->showMessage(QString::fromStdString(error));
+        return;
+    }
+    if (followedPoints.size() == first) {
+        return;
     }
 
-    double meanX = sumX / n;
-    double meanY = sumY / n;
+    // 새 점만 스케일 조정하고 그린다
+    QPainterPath pointPath;
+    pointPath.setFillRule(Qt::WindingFill);
+    for (std::size_t i = first; i < followedPoints.size(); i++) {
+        double scaled_x = -(followedPoints.x[i] * 2);
+        followedPoints.x[i] = scaled_x;
+        pointPath.addEllipse(scaled_x - 2, followedPoints.y[i] - 2, 4, 4);
+    }
 
-    // 최소제곱법 공식 적용
-    if (std::abs(n * sumX2 - sumX * sumX) < 0.0001) {
-        model.a = 0;
-        model.b = meanY;
-    } else {
-        model.a = (n * sumXY - sumX * sumY) / (n * sumX2 - sumX * sumX);
-        model.b = meanY - model.a * meanX;
+    vision::LineModel model;
+    {
+        vision::ScopedTimer timer(&stats, vision::Stage::LeastSquares);
+        followedFit.update(followedPoints.view());
+        model = followedFit.model();
+    }
+    {
+        vision::ScopedTimer timer(&stats, vision::Stage::Scene);
+        scene->addPath(pointPath, QPen(Qt::blue), QBrush(Qt::blue));
+        delete followedLine;
+        followedLine = drawLine(model, Qt::red);
     }
 
-    return model;
+    showStats(QString("a: %1  b: %2  points: %3 (+%4)  rejected: %5")
+                  .arg(model.a)
+                  .arg(model.b)
+                  .arg(followedPoints.size())
+                  .arg(followedPoints.size() - first)
+                  .arg(tail.csvStats().rejectedRows),
+              stats);
 }
 
-double MainWindow::calculateError(const QVector<QPointF>& points, const LineModel& model)
+void MainWindow::showStats(const QString &message, const vision::Stats &stats)
 {
-    double totalError = 0;
-
-    // 각 점에서 직선까지의 수직 거리의 제곱의 합 계산
-    for (const QPointF& point : points) {
-        double predicted_y = model.a * point.x() + model.b;
-        double error = point.y() - predicted_y;
-        totalError += error * error;
-    }
-
-    return totalError;
+    // 상태 표시줄에는 요약, 전체는 JSON 으로 디버그 출력
+    qDebug().noquote() << "Stats:" << QString::fromStdString(stats.toJson());
+    ui->statusbar->showMessage(message + "  |  " + QString::fromStdString(stats.summary()));
 }
 
-void MainWindow::drawLine(const LineModel& model, const QColor& color)
+QGraphicsLineItem *MainWindow::drawLine(const vision::LineModel& model, const QColor& color)
 {
     // 모델 선 그리기
     double x1 = 0;
@@ -167,5 +342,5 @@ void MainWindow::drawLine(const LineModel& model, const QColor& color)
 
     QPen modelPen(color);
     modelPen.setWidth(2);
-    scene->addLine(x1, y1, x2, y2, modelPen);
+    return scene->addLine(x1, y1, x2, y2, modelPen);
 }
@@ -3,8 +3,22 @@
 
 #include <QMainWindow>
 #include <QGraphicsScene>
-#include <QPointF>
-#include <QVector>
+#include <QFutureWatcher>
+#include <QPainterPath>
+#include <QString>
+#include <memory>
+
+#include "csv_loader.h"
+#include "csv_tail.h"
+#include "incremental.h"
+#include "job_control.h"
+#include "stats.h"
+#include "line_fit.h"
+
+class QFileSystemWatcher;
+class QGraphicsLineItem;
+class QProgressBar;
+class QPushButton;
 
 namespace Ui {
 class MainWindow;
@@ -15,27 +29,57 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget *parent = nullptr);
+    // followFile 을 주면 내장 데이터 대신 그 파일을 읽고, 이후 뒤에 추가되는
+    // 행만 읽어서 모델을 갱신한다 (팔로우 모드)
+    explicit MainWindow(QWidget *parent = nullptr, const QString &followFile = QString());
     ~MainWindow();
 
 private:
-    // 직선 모델을 위한 구조체
-    struct LineModel {
-        double a;  // slope
-        double b;  // intercept
+    // 작업 스레드에서 만들어 GUI 스레드로 넘기는 결과
+    struct LoadResult {
+        vision::LineModel model;
+        double totalError = 0;
+        std::size_t pointCount = 0;
+        QPainterPath pointPath;  // 점마다 아이템을 만들지 않고 path 하나로 그린다
+        vision::Stats stats;     // 단계별 시간과 카운터
+        vision::CsvStats csv;    // 행 수와 잘못된 행의 줄 번호
+        QString error;
+        bool cancelled = false;
     };
 
     Ui::MainWindow *ui;
     QGraphicsScene *scene;
 
+    // 백그라운드 작업
+    QFutureWatcher<LoadResult> loadWatcher;
+    std::shared_ptr<vision::JobControl> loadControl;
+    QProgressBar *progressBar;
+    QPushButton *cancelButton;
+
+    // 팔로우 모드 (GUI 스레드에서 새 행만 처리)
+    QFileSystemWatcher *fileWatcher;
+    QString followedFile;
+    vision::CsvTail tail;
+    vision::PointSet followedPoints;
+    vision::IncrementalLineFit followedFit;
+    QGraphicsLineItem *followedLine = nullptr;
+
     // 기본 함수
     void drawAxes();
-    void loadCSVData(const QString &fileName);
+    void loadCSVData(const QString &fileName);  // 파싱 + 최소제곱법을 백그라운드로 시작
+    void cancelLoad();
+    void onLoadProgress(double fraction);
+    void onLoadFinished();
+    void showStats(const QString &message, const vision::Stats &stats);
+    void reportRejectedRows(const vision::CsvStats &csv);
+    void startFollow(const QString &fileName);
+    void onFollowedFileChanged();
+
+    // 작업 스레드에서 실행 (scene 에 접근하지 않음)
+    static LoadResult runLoad(const QString &fileName, vision::JobControl *control);
 
-    // 최소제곱법 관련 함수
-    LineModel fitLineWithLeastSquares(const QVector<QPointF>& points);
-    double calculateError(const QVector<QPointF>& points, const LineModel& model);
-    void drawLine(const LineModel& model, const QColor& color);
+    // 최소제곱법 계산은 vision_core (vision::fitLineLeastSquares)
+    QGraphicsLineItem *drawLine(const vision::LineModel& model, const QColor& color);
 };
 
 #endif // MAINWINDOW_H
@@ -17,19 +17,50 @@ k = 2 경우 x좌표가 음수인 그룹과 양수인 그룹으로 나눌 수 
 */
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "csv_loader.h"
+#include "embedded_dataset.h"
+#if VISION_HAVE_EMBEDDED_DATA
+#include "embedded_clusterData.h"
+#endif
 #include <QFile>
-#include <QTextStream>
-#include <QGraphicsEllipseItem>
+#include <QFileSystemWatcher>
 #include <QPen>
 #include <QDebug>
-#include <cmath>
-#include <random>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QStringList>
+#include <QtConcurrent/QtConcurrentRun>
 #include <algorithm>
 
-MainWindow::MainWindow(QWidget *parent)
+namespace {
+
+// 기본 데이터 (qrc)
+const char defaultDataFile[] = ":/resources/data/cluster_data_.csv";
+
+// 빌드할 때 미리 파싱해 둔 기본 데이터. 만들지 못한 빌드(크로스 컴파일)면
+// nullptr 이고 qrc 의 CSV 를 파싱한다.
+const vision::EmbeddedDataset *embeddedData(const QString &fileName)
+{
+#if VISION_HAVE_EMBEDDED_DATA
+    if (fileName == defaultDataFile) {
+        return &vision::embedded::clusterData;
+    }
+#else
+    Q_UNUSED(fileName);
+#endif
+    return nullptr;
+}
+
+// getClusterColor 가 구분하는 색 수 (0, 1, 2, 나머지)
+const int clusterColorCount = 4;
+
+} // namespace
+
+MainWindow::MainWindow(QWidget *parent, const QString &followFile)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , scene(new QGraphicsScene(this))
+    , fileWatcher(new QFileSystemWatcher(this))
 {
     ui->setupUi(this);
 
@@ -39,12 +70,33 @@ MainWindow::MainWindow(QWidget *parent)
     ui->graphicsView->scale(-2, -2);
     ui->graphicsView->setSceneRect(-100, -500, 200, 10000);
 
+    // 진행률 표시와 취소 버튼 (작업 중에만 보임)
+    progressBar = new QProgressBar(this);
+    progressBar->setRange(0, 100);
+    progressBar->setMaximumWidth(200);
+    cancelButton = new QPushButton(tr("취소"), this);
+    ui->statusbar->addPermanentWidget(progressBar);
+    ui->statusbar->addPermanentWidget(cancelButton);
+    progressBar->hide();
+    cancelButton->hide();
+
+    connect(cancelButton, &QPushButton::clicked, this, &MainWindow::cancelLoad);
+    connect(&loadWatcher, &QFutureWatcher<LoadResult>::finished, this, &MainWindow::onLoadFinished);
+    connect(fileWatcher, &QFileSystemWatcher::fileChanged, this, &MainWindow::onFollowedFileChanged);
+
     drawAxes();
-    loadCSVData(":/resources/data/cluster_data_.csv");
+    if (followFile.isEmpty()) {
+        loadCSVData(defaultDataFile);
+    } else {
+        startFollow(followFile);
+    }
 }
 
 MainWindow::~MainWindow()
 {
+    // 작업 스레드가 this 를 참조하지 않도록 끝날 때까지 기다린다
+    cancelLoad();
+    loadWatcher.waitForFinished();
     delete ui;
 }
 
@@ -58,206 +110,264 @@ void MainWindow::drawAxes()
 
 void MainWindow::loadCSVData(const QString &fileName)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Cannot open file for reading:" << file.errorString();
-        return;
+    // 이전 작업이 남아 있으면 취소
+    cancelLoad();
+    loadWatcher.waitForFinished();
+
+    auto control = std::make_shared<vision::JobControl>([this](double fraction) {
+        QMetaObject::invokeMethod(this, [this, fraction] { onLoadProgress(fraction); },
+                                  Qt::QueuedConnection);
+    });
+    loadControl = control;
+
+    progressBar->setValue(0);
+    progressBar->show();
+    cancelButton->show();
+    ui->statusbar->showMessage(tr("K-means 계산 중..."));
+
+    loadWatcher.setFuture(QtConcurrent::run([fileName, control] {
+        return runLoad(fileName, control.get());
+    }));
+}
+
+void MainWindow::cancelLoad()
+{
+    if (loadControl) {
+        loadControl->cancel();
     }
+}
 
-    QTextStream in(&file);
-    QString headerLine = in.readLine();  // 헤더 스킵
+void MainWindow::onLoadProgress(double fraction)
+{
+    progressBar->setValue(static_cast<int>(fraction * 100));
+}
 
-    QVector<QPointF> points;
+MainWindow::LoadResult MainWindow::runLoad(const QString &fileName, vision::JobControl *control)
+{
+    LoadResult result;
+
+    // x, y 는 좌표, label 은 평가용 정답으로 같이 읽는다 (전체 진행률의 20%)
+    vision::PointSet points;
+    if (const vision::EmbeddedDataset *embedded = embeddedData(fileName)) {
+        embedded->copyTo(points);  // 빌드할 때 같은 옵션으로 파싱한 배열을 복사만
+        result.csv = embedded->csvStats();
+    } else {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            result.error = file.errorString();
+            return result;
+        }
 
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        QStringList values = line.split(",");
+        // 파일을 매핑해서 복사 없이 파싱. 압축된 qrc 리소스처럼 매핑이 안 되면 readAll
+        QByteArray buffer;
+        const char *data = reinterpret_cast<const char *>(file.map(0, file.size()));
+        std::size_t size = static_cast<std::size_t>(file.size());
+        if (!data) {
+            buffer = file.readAll();
+            data = buffer.constData();
+            size = static_cast<std::size_t>(buffer.size());
+        }
 
-        if (values.size() >= 2) {  // x, y, label 중 x, y만 사용
-            bool okX, okY;
-            double x = values[0].toDouble(&okX);
-            double y = values[1].toDouble(&okY);
+        vision::CsvOptions options;
+        options.maxColumns = -1;
+        options.labelColumn = 2;
 
-            if (okX && okY) {
-                double scaled_x = -(x * 2);
-                points.append(QPointF(scaled_x, y));
-            }
-        }
+        control->setProgressRange(0.0, 0.2);
+        result.csv = vision::parseCsv(data, size, options, points, control, &result.stats);
+    }
+    for (double &x : points.x) {
+        x = -(x * 2);
     }
-    file.close();
 
     // k값 직접 지정
-    const int k = 3;  // 원하는 k값으로 변경 가능
+    vision::KMeansParams params;
+    params.k = 3;  // 원하는 k값으로 변경 가능
+    params.maxIterations = 100;
 
     // K-means 클러스터링 수행
-    QVector<Point> clusteredPoints = initializeClusters(points);
-    QVector<Centroid> centroids = initializeCentroids(clusteredPoints, k);
-
-    bool converged = false;
-    int maxIterations = 100;
-    int iteration = 0;
-
-    while (!converged && iteration < maxIterations) {
-        updateClusters(clusteredPoints, centroids);
-        QVector<Centroid> newCentroids = updateCentroids(clusteredPoints, k);
-        converged = hasConverged(centroids, newCentroids);
-        centroids = newCentroids;
-        iteration++;
+    control->setProgressRange(0.2, 1.0);
+    result.clustering = vision::kmeans(points.view(), params, control, &result.stats);
+    result.cancelled = control->isCancelled();
+    if (points.hasLabels() && result.clustering.labels.size() == points.size()) {
+        result.agreement = vision::compareClusterings(points.labels.data(),
+                                                      result.clustering.labels.data(),
+                                                      points.size());
     }
 
-    qDebug() << "K-means converged after" << iteration << "iterations";
-    qDebug() << "Final WSS:" << calculateWSS(clusteredPoints, centroids);
-
-    // 클러스터 시각화
-    visualizeClusters(clusteredPoints);
-}
-
-QVector<MainWindow::Point> MainWindow::initializeClusters(const QVector<QPointF>& points)
-{
-    QVector<Point> result;
-    for (const QPointF& p : points) {
-        result.append(Point(p.x(), p.y(), -1));
+    // 클러스터 색상별로 점 path 생성
+    vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+    result.clusterPaths.resize(clusterColorCount);
+    for (QPainterPath &path : result.clusterPaths) {
+        path.setFillRule(Qt::WindingFill);
+    }
+    const std::vector<int> &labels = result.clustering.labels;
+    for (std::size_t i = 0; i < labels.size(); i++) {
+        const int colorIndex = labels[i] >= 0 ? std::min(labels[i], clusterColorCount - 1)
+                                              : clusterColorCount - 1;
+        result.clusterPaths[colorIndex].addEllipse(points.x[i] - 2, points.y[i] - 2, 4, 4);
     }
+
     return result;
 }
 
-QVector<MainWindow::Centroid> MainWindow::initializeCentroids(const QVector<Point>& points, int k)
+void MainWindow::onLoadFinished()
 {
-    QVector<Centroid> centroids;
-
-    // k-means++ 초기화 사용
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, points.size() - 1);
-
-    // 첫 번째 centroid 무작위 선택
-    int firstIdx = dis(gen);
-    centroids.append(Centroid(points[firstIdx].x, points[firstIdx].y));
-
-    // 나머지 centroids 선택
-    for (int i = 1; i < k; i++) {
-        QVector<double> distances(points.size(), std::numeric_limits<double>::max());
-        double totalDistance = 0;
-
-        // 각 점에서 가장 가까운 centroid까지의 거리 계산
-        for (int j = 0; j < points.size(); j++) {
-            for (const Centroid& centroid : centroids) {
-                double dist = std::pow(points[j].x - centroid.x, 2) +
-                            std::pow(points[j].y - centroid.y, 2);
-                distances[j] = std::min(distances[j], dist);
-            }
-            totalDistance += distances[j];
-        }
+    progressBar->hide();
+    cancelButton->hide();
 
-        // 확률에 따라 다음 centroid 선택
-        std::uniform_real_distribution<> realDis(0, totalDistance);
-        double rand = realDis(gen);
-        double sum = 0;
-        int centroidIdx = 0;
-
-        for (int j = 0; j < points.size(); j++) {
-            sum += distances[j];
-            if (sum > rand) {
-                centroidIdx = j;
-                break;
-            }
-        }
-
-        centroids.append(Centroid(points[centroidIdx].x, points[centroidIdx].y));
+    LoadResult result = loadWatcher.result();
+    if (!result.error.isEmpty()) {
+        qWarning() << "Cannot open file for reading:" << result.error;
+        ui->statusbar->showMessage(result.error);
+        return;
+    }
+    if (result.cancelled) {
+        ui->statusbar->showMessage(tr("취소됨"));
+        return;
     }
+    reportRejectedRows(result.csv);
 
-    return centroids;
-}
+    qDebug() << "K-means converged after" << result.clustering.iterations << "iterations";
+    qDebug() << "Final WSS:" << result.clustering.wss;
 
-void MainWindow::updateClusters(QVector<Point>& points, const QVector<Centroid>& centroids)
-{
-    for (Point& point : points) {
-        double minDist = std::numeric_limits<double>::max();
-        int closestCluster = 0;
-
-        for (int i = 0; i < centroids.size(); i++) {
-            double dist = calculateDistance(point, centroids[i]);
-            if (dist < minDist) {
-                minDist = dist;
-                closestCluster = i;
-            }
-        }
-        point.cluster = closestCluster;
+    // 클러스터 시각화
+    {
+        vision::ScopedTimer timer(&result.stats, vision::Stage::Scene);
+        visualizeClusters(result.clusterPaths);
+    }
+    QString message = QString("k: %1  iterations: %2  WSS: %3")
+                          .arg(result.clustering.centroids.size())
+                          .arg(result.clustering.iterations)
+                          .arg(result.clustering.wss);
+    if (result.agreement.points > 0) {
+        qDebug() << "Purity:" << result.agreement.purity
+                 << "ARI:" << result.agreement.adjustedRandIndex;
+        message += QString("  purity: %1  ARI: %2")
+                       .arg(result.agreement.purity)
+                       .arg(result.agreement.adjustedRandIndex);
     }
+    showStats(message, result.stats);
 }
 
-QVector<MainWindow::Centroid> MainWindow::updateCentroids(const QVector<Point>& points, int k)
+void MainWindow::reportRejectedRows(const vision::CsvStats &csv)
 {
-    QVector<Centroid> newCentroids(k, Centroid(0, 0));
-    QVector<int> counts(k, 0);
-
-    for (const Point& point : points) {
-        if (point.cluster >= 0 && point.cluster < k) {
-            newCentroids[point.cluster].x += point.x;
-            newCentroids[point.cluster].y += point.y;
-            counts[point.cluster]++;
-        }
-    }
+    // 건너뛴 행을 조용히 버리지 않고 줄 번호와 함께 알린다
+    if (csv.rejectedRows == 0) return;
 
-    for (int i = 0; i < k; i++) {
-        if (counts[i] > 0) {
-            newCentroids[i].x /= counts[i];
-            newCentroids[i].y /= counts[i];
-        }
+    QStringList lines;
+    for (std::size_t line : csv.rejectedLines) {
+        lines << QString::number(line);
     }
-
-    return newCentroids;
+    if (csv.rejectedRows > csv.rejectedLines.size()) {
+        lines << "...";
+    }
+    qWarning().noquote() << QString("Skipped %1 of %2 rows (line %3)")
+                                .arg(csv.rejectedRows)
+                                .arg(csv.rows)
+                                .arg(lines.join(", "));
 }
 
-double MainWindow::calculateDistance(const Point& point, const Centroid& centroid)
+void MainWindow::startFollow(const QString &fileName)
 {
-    return std::sqrt(std::pow(point.x - centroid.x, 2) + std::pow(point.y - centroid.y, 2));
+    // x, y, label 중 x, y만 사용
+    vision::CsvOptions options;
+    options.maxColumns = -1;
+
+    vision::KMeansParams params;
+    params.k = 3;
+    params.maxIterations = 100;
+
+    followedFile = fileName;
+    tail.open(QFile::encodeName(fileName).toStdString(), options);
+    followedPoints.clear();
+    followedKMeans = vision::IncrementalKMeans(params);
+    drawnPoints = 0;
+
+    scene->clear();
+    drawAxes();
+
+    if (!fileWatcher->files().contains(fileName)) {
+        fileWatcher->addPath(fileName);
+    }
+    onFollowedFileChanged();
 }
 
-bool MainWindow::hasConverged(const QVector<Centroid>& oldCentroids,
-                            const QVector<Centroid>& newCentroids,
-                            double tolerance)
+void MainWindow::onFollowedFileChanged()
 {
-    if (oldCentroids.size() != newCentroids.size()) return false;
+    // 파일을 새로 만들어 바꿔치기하는 프로그램이면 감시가 풀리므로 다시 등록
+    if (!fileWatcher->files().contains(followedFile) && QFile::exists(followedFile)) {
+        fileWatcher->addPath(followedFile);
+    }
 
-    for (int i = 0; i < oldCentroids.size(); i++) {
-        if (std::abs(oldCentroids[i].x - newCentroids[i].x) > tolerance ||
-            std::abs(oldCentroids[i].y - newCentroids[i].y) > tolerance) {
-            return false;
-        }
+    // 추가된 바이트만 파싱
+    vision::Stats stats;
+    const std::size_t first = followedPoints.size();
+    std::string error;
+    vision::CsvTail::PollStatus status;
+    {
+        vision::ScopedTimer timer(&stats, vision::Stage::Parse);
+        status = tail.poll(followedPoints, &error);
+    }
+    if (status == vision::CsvTail::PollStatus::Truncated) {
+        startFollow(followedFile);  // 잘리거나 교체됨: 처음부터 다시
+        return;
+    }
+    if (status == vision::CsvTail::PollStatus::Error) {
+        ui->statusbar->showMessage(QString::fromStdString(error));
+        return;
     }
-    return true;
+    if (followedPoints.size() == first) {
+        return;
+    }
+    for (std::size_t i = first; i < followedPoints.size(); i++) {
+        followedPoints.x[i] = -(followedPoints.x[i] * 2);
+    }
+
+    // 새 점만 가장 가까운 centroid 에 붙인다 (처음 k 개가 모이면 전체 k-means 로 시작)
+    followedKMeans.update(followedPoints.view(), &stats);
+    const vision::KMeansResult &clustering = followedKMeans.result();
+
+    // 라벨이 새로 정해진 점만 색상별 path 로 추가
+    vision::ScopedTimer timer(&stats, vision::Stage::Scene);
+    QVector<QPainterPath> clusterPaths(clusterColorCount);
+    for (QPainterPath &path : clusterPaths) {
+        path.setFillRule(Qt::WindingFill);
+    }
+    const std::vector<int> &labels = clustering.labels;
+    for (std::size_t i = drawnPoints; i < labels.size(); i++) {
+        const int colorIndex = labels[i] >= 0 ? std::min(labels[i], clusterColorCount - 1)
+                                              : clusterColorCount - 1;
+        clusterPaths[colorIndex].addEllipse(followedPoints.x[i] - 2, followedPoints.y[i] - 2, 4, 4);
+    }
+    drawnPoints = labels.size();
+    for (int cluster = 0; cluster < clusterPaths.size(); cluster++) {
+        QColor color = getClusterColor(cluster);
+        scene->addPath(clusterPaths[cluster], QPen(color), QBrush(color));
+    }
+
+    showStats(QString("k: %1  points: %2 (+%3)  WSS: %4")
+                  .arg(clustering.centroids.size())
+                  .arg(followedPoints.size())
+                  .arg(followedPoints.size() - first)
+                  .arg(clustering.wss),
+              stats);
 }
 
-double MainWindow::calculateWSS(const QVector<Point>& points, const QVector<Centroid>& centroids)
+void MainWindow::showStats(const QString &message, const vision::Stats &stats)
 {
-    double wss = 0;
-    for (const Point& point : points) {
-        double minDist = std::numeric_limits<double>::max();
-        for (const Centroid& centroid : centroids) {
-            double dist = std::pow(point.x - centroid.x, 2) + std::pow(point.y - centroid.y, 2);
-            minDist = std::min(minDist, dist);
-        }
-        wss += minDist;
-    }
-    return wss;
+    // 상태 표시줄에는 요약, 전체는 JSON 으로 디버그 출력
+    qDebug().noquote() << "Stats:" << QString::fromStdString(stats.toJson());
+    ui->statusbar->showMessage(message + "  |  " + QString::fromStdString(stats.summary()));
 }
 
-void MainWindow::visualizeClusters(const QVector<Point>& points)
+void MainWindow::visualizeClusters(const QVector<QPainterPath>& clusterPaths)
 {
     scene->clear();
     drawAxes();
 
-    for (const Point& point : points) {
-        QColor color = getClusterColor(point.cluster);
-        QPen pointPen(color);
-        QBrush pointBrush(color);
-
-        QGraphicsEllipseItem *pointItem =
-            new QGraphicsEllipseItem(point.x - 2, point.y - 2, 4, 4);
-        pointItem->setPen(pointPen);
-        pointItem->setBrush(pointBrush);
-        scene->addItem(pointItem);
+    for (int cluster = 0; cluster < clusterPaths.size(); cluster++) {
+        QColor color = getClusterColor(cluster);
+        scene->addPath(clusterPaths[cluster], QPen(color), QBrush(color));
     }
 }
 
@@ -3,8 +3,23 @@
 
 #include <QMainWindow>
 #include <QGraphicsScene>
-#include <QPointF>
+#include <QFutureWatcher>
+#include <QPainterPath>
+#include <QString>
 #include <QVector>
+#include <memory>
+
+#include "cluster_eval.h"
+#include "csv_loader.h"
+#include "csv_tail.h"
+#include "incremental.h"
+#include "job_control.h"
+#include "stats.h"
+#include "kmeans.h"
+
+class QFileSystemWatcher;
+class QProgressBar;
+class QPushButton;
 
 namespace Ui {
 class MainWindow;
@@ -15,47 +30,57 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget *parent = nullptr);
+    // followFile 을 주면 내장 데이터 대신 그 파일을 읽고, 이후 뒤에 추가되는
+    // 행만 읽어서 클러스터를 갱신한다 (팔로우 모드)
+    explicit MainWindow(QWidget *parent = nullptr, const QString &followFile = QString());
     ~MainWindow();
 
 private:
-    struct Point {
-        double x;
-        double y;
-        int cluster;  // 클러스터 라벨
-        Point(double x = 0, double y = 0, int c = -1)
-            : x(x), y(y), cluster(c) {}
-    };
-
-    struct Centroid {
-        double x;
-        double y;
-        Centroid(double x = 0, double y = 0) : x(x), y(y) {}
+    // 작업 스레드에서 만들어 GUI 스레드로 넘기는 결과
+    struct LoadResult {
+        vision::KMeansResult clustering;
+        QVector<QPainterPath> clusterPaths;  // getClusterColor 색상별 점 path
+        vision::ClusterAgreement agreement;  // 정답 라벨과의 비교 (points 가 0 이면 라벨 없음)
+        vision::Stats stats;     // 단계별 시간과 카운터
+        vision::CsvStats csv;    // 행 수와 잘못된 행의 줄 번호
+        QString error;
+        bool cancelled = false;
     };
 
     Ui::MainWindow *ui;
     QGraphicsScene *scene;
 
+    // 백그라운드 작업
+    QFutureWatcher<LoadResult> loadWatcher;
+    std::shared_ptr<vision::JobControl> loadControl;
+    QProgressBar *progressBar;
+    QPushButton *cancelButton;
+
+    // 팔로우 모드 (GUI 스레드에서 새 행만 처리)
+    QFileSystemWatcher *fileWatcher;
+    QString followedFile;
+    vision::CsvTail tail;
+    vision::PointSet followedPoints;
+    vision::IncrementalKMeans followedKMeans;
+    std::size_t drawnPoints = 0;  // 라벨이 정해져 그린 점 수
+
     // 기본 함수
     void drawAxes();
-    void loadCSVData(const QString &fileName);
-
-    // K-means 클러스터링 관련 함수
-    QVector<Point> initializeClusters(const QVector<QPointF>& points);
-    QVector<Centroid> initializeCentroids(const QVector<Point>& points, int k);
-    void updateClusters(QVector<Point>& points, const QVector<Centroid>& centroids);
-    QVector<Centroid> updateCentroids(const QVector<Point>& points, int k);
-    double calculateDistance(const Point& point, const Centroid& centroid);
-    bool hasConverged(const QVector<Centroid>& oldCentroids,
-                     const QVector<Centroid>& newCentroids,
-                     double tolerance = 0.0001);
-
-    // 엘보우 메서드 관련 함수
-    double calculateWSS(const QVector<Point>& points, const QVector<Centroid>& centroids);
-    int findOptimalK(const QVector<QPointF>& points, int minK = 1, int maxK = 10);
+    void loadCSVData(const QString &fileName);  // 파싱 + K-means 를 백그라운드로 시작
+    void cancelLoad();
+    void onLoadProgress(double fraction);
+    void onLoadFinished();
+    void showStats(const QString &message, const vision::Stats &stats);
+    void reportRejectedRows(const vision::CsvStats &csv);
+    void startFollow(const QString &fileName);
+    void onFollowedFileChanged();
+
+    // 작업 스레드에서 실행 (scene 에 접근하지 않음).
+    // K-means 클러스터링은 vision_core (vision::kmeans)
+    static LoadResult runLoad(const QString &fileName, vision::JobControl *control);
 
     // 시각화 함수
-    void visualizeClusters(const QVector<Point>& points);
+    void visualizeClusters(const QVector<QPainterPath>& clusterPaths);
     QColor getClusterColor(int cluster);
 };
 
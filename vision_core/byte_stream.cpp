@@ -0,0 +1,386 @@
+#include "byte_stream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if VISION_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#if VISION_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace vision {
+
+namespace {
+
+// 압축 해제기가 한 번에 원본에서 읽는 크기
+const std::size_t inputChunkBytes = 256 * 1024;
+
+bool hasSuffix(const std::string &text, const char *suffix)
+{
+    const std::size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+class FileByteStream : public ByteStream
+{
+public:
+    FileByteStream(std::FILE *file, const std::string &path) : file(file), path(path) {}
+    ~FileByteStream() override { std::fclose(file); }
+
+    std::size_t read(char *data, std::size_t size) override
+    {
+        const std::size_t got = std::fread(data, 1, size, file);
+        offset += got;
+        if (got < size && std::ferror(file)) {
+            failure = "Read error: " + path;
+        }
+        return got;
+    }
+
+    std::string error() const override { return failure; }
+    std::size_t sourceBytesRead() const override { return offset; }
+
+private:
+    std::FILE *file;
+    std::string path;
+    std::size_t offset = 0;
+    std::string failure;
+};
+
+#if VISION_HAVE_ZLIB
+
+class GzipByteStream : public ByteStream
+{
+public:
+    explicit GzipByteStream(std::unique_ptr<ByteStream> source)
+        : source(std::move(source))
+        , input(inputChunkBytes)
+    {
+        // 15 + 32: gzip / zlib 헤더 자동 인식
+        if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+            failure = "Cannot initialize zlib";
+        }
+        initialized = failure.empty();
+    }
+
+    ~GzipByteStream() override
+    {
+        if (initialized) inflateEnd(&stream);
+    }
+
+    std::size_t read(char *data, std::size_t size) override
+    {
+        if (!failure.empty() || done) {
+            return 0;
+        }
+
+        stream.next_out = reinterpret_cast<Bytef *>(data);
+        stream.avail_out = static_cast<uInt>(std::min<std::size_t>(size, 1u << 30));
+        const uInt wanted = stream.avail_out;
+
+        while (stream.avail_out > 0) {
+            if (stream.avail_in == 0) {
+                const std::size_t got = source->read(input.data(), input.size());
+                if (got == 0) {
+                    if (!source->error().empty()) {
+                        failure = source->error();
+                    } else if (!memberEnded) {
+                        failure = "Truncated gzip stream";
+                    }
+                    done = true;
+                    break;
+                }
+                stream.next_in = reinterpret_cast<Bytef *>(input.data());
+                stream.avail_in = static_cast<uInt>(got);
+            }
+
+            // gzip 멤버가 여러 개 이어 붙어 있을 수 있다 (cat a.gz b.gz)
+            if (memberEnded) {
+                inflateReset(&stream);
+                memberEnded = false;
+            }
+
+            const int status = inflate(&stream, Z_NO_FLUSH);
+            if (status == Z_STREAM_END) {
+                memberEnded = true;
+            } else if (status != Z_OK && status != Z_BUF_ERROR) {
+                failure = std::string("gzip: ") + (stream.msg ? stream.msg : "inflate failed");
+                break;
+            }
+        }
+        return wanted - stream.avail_out;
+    }
+
+    std::string error() const override { return failure; }
+    std::size_t sourceBytesRead() const override { return source->sourceBytesRead(); }
+
+private:
+    std::unique_ptr<ByteStream> source;
+    std::vector<char> input;
+    z_stream stream = {};
+    bool initialized = false;
+    bool memberEnded = false;
+    bool done = false;
+    std::string failure;
+};
+
+#endif
+
+#if VISION_HAVE_ZSTD
+
+class ZstdByteStream : public ByteStream
+{
+public:
+    explicit ZstdByteStream(std::unique_ptr<ByteStream> source)
+        : source(std::move(source))
+        , input(ZSTD_DStreamInSize())
+        , stream(ZSTD_createDStream())
+    {
+        if (!stream) {
+            failure = "Cannot initialize zstd";
+        }
+    }
+
+    ~ZstdByteStream() override
+    {
+        ZSTD_freeDStream(stream);
+    }
+
+    std::size_t read(char *data, std::size_t size) override
+    {
+        if (!failure.empty()) {
+            return 0;
+        }
+
+        ZSTD_outBuffer out = {data, size, 0};
+        while (out.pos < out.size) {
+            if (in.pos == in.size) {
+                const std::size_t got = source->read(input.data(), input.size());
+                if (got == 0) {
+                    if (!source->error().empty()) {
+                        failure = source->error();
+                    } else if (!frameEnded) {
+                        failure = "Truncated zstd stream";
+                    }
+                    break;
+                }
+                in = {input.data(), got, 0};
+            }
+
+            const std::size_t status = ZSTD_decompressStream(stream, &out, &in);
+            if (ZSTD_isError(status)) {
+                failure = std::string("zstd: ") + ZSTD_getErrorName(status);
+                break;
+            }
+            frameEnded = status == 0;
+        }
+        return out.pos;
+    }
+
+    std::string error() const override { return failure; }
+    std::size_t sourceBytesRead() const override { return source->sourceBytesRead(); }
+
+private:
+    std::unique_ptr<ByteStream> source;
+    std::vector<char> input;
+    ZSTD_inBuffer in = {nullptr, 0, 0};
+    ZSTD_DStream *stream;
+    bool frameEnded = true;
+    std::string failure;
+};
+
+#endif
+
+} // namespace
+
+Compression detectCompression(const unsigned char *data, std::size_t size)
+{
+    if (size >= 2 && data[0] == 0x1f && data[1] == 0x8b) {
+        return Compression::Gzip;
+    }
+    if (size >= 4 && data[0] == 0x28 && data[1] == 0xb5 && data[2] == 0x2f && data[3] == 0xfd) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+const char *compressionName(Compression compression)
+{
+    switch (compression) {
+        case Compression::None: return "none";
+        case Compression::Gzip: return "gzip";
+        case Compression::Zstd: return "zstd";
+    }
+    return "";
+}
+
+Compression fileCompression(const std::string &path)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return Compression::None;
+    }
+    unsigned char magic[4] = {};
+    const std::size_t size = std::fread(magic, 1, sizeof(magic), file);
+    std::fclose(file);
+    return detectCompression(magic, size);
+}
+
+PrefetchByteStream::PrefetchByteStream(std::unique_ptr<ByteStream> source, std::size_t blockBytes)
+    : source(std::move(source))
+{
+    for (Block &block : blocks) {
+        block.data.resize(std::max<std::size_t>(blockBytes, 4096));
+    }
+    producer = std::thread(&PrefetchByteStream::producerLoop, this);
+}
+
+PrefetchByteStream::~PrefetchByteStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    blockFree.notify_all();
+    producer.join();
+}
+
+void PrefetchByteStream::producerLoop()
+{
+    int fill = 0;
+    for (;;) {
+        Block &block = blocks[fill];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            blockFree.wait(lock, [&] { return stopping || !block.ready; });
+            if (stopping) return;
+        }
+
+        // ready 가 아닌 블록은 소비자가 건드리지 않으므로 잠그지 않고 채운다
+        std::size_t filled = 0;
+        while (filled < block.data.size()) {
+            const std::size_t got = source->read(block.data.data() + filled, block.data.size() - filled);
+            if (got == 0) break;
+            filled += got;
+        }
+        const bool last = filled < block.data.size();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            block.size = filled;
+            block.last = last;
+            block.ready = true;
+            sourceBytes = source->sourceBytesRead();
+            if (last) failure = source->error();
+        }
+        blockReady.notify_one();
+
+        if (last) return;
+        fill ^= 1;
+    }
+}
+
+std::size_t PrefetchByteStream::read(char *data, std::size_t size)
+{
+    std::size_t total = 0;
+    while (total < size && !finished) {
+        Block &block = blocks[consumerBlock];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            blockReady.wait(lock, [&] { return block.ready; });
+        }
+
+        const std::size_t count = std::min(block.size - consumerOffset, size - total);
+        std::memcpy(data + total, block.data.data() + consumerOffset, count);
+        consumerOffset += count;
+        total += count;
+
+        if (consumerOffset == block.size) {
+            if (block.last) {
+                finished = true;
+                break;
+            }
+            // 다 읽은 블록을 돌려주고 다음 블록으로
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                block.ready = false;
+            }
+            blockFree.notify_one();
+            consumerOffset = 0;
+            consumerBlock ^= 1;
+        }
+    }
+    return total;
+}
+
+std::string PrefetchByteStream::error() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return failure;
+}
+
+std::size_t PrefetchByteStream::sourceBytesRead() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return sourceBytes;
+}
+
+std::unique_ptr<ByteStream> openByteStream(const std::string &path, std::string *error,
+                                           Compression *compression)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        if (error) *error = "Cannot open file for reading: " + path;
+        return nullptr;
+    }
+
+    unsigned char magic[4] = {};
+    const std::size_t magicSize = std::fread(magic, 1, sizeof(magic), file);
+    if (std::fseek(file, 0, SEEK_SET) != 0) {
+        std::fclose(file);
+        if (error) *error = "Cannot seek: " + path;
+        return nullptr;
+    }
+
+    const Compression detected = detectCompression(magic, magicSize);
+    if (compression) *compression = detected;
+
+    std::unique_ptr<ByteStream> raw(new FileByteStream(file, path));
+    switch (detected) {
+        case Compression::None:
+            return raw;
+        case Compression::Gzip:
+#if VISION_HAVE_ZLIB
+            return std::unique_ptr<ByteStream>(new PrefetchByteStream(
+                std::unique_ptr<ByteStream>(new GzipByteStream(std::move(raw)))));
+#else
+            break;
+#endif
+        case Compression::Zstd:
+#if VISION_HAVE_ZSTD
+            return std::unique_ptr<ByteStream>(new PrefetchByteStream(
+                std::unique_ptr<ByteStream>(new ZstdByteStream(std::move(raw)))));
+#else
+            break;
+#endif
+    }
+
+    if (error) {
+        *error = std::string(compressionName(detected)) + " support is not built in: " + path;
+    }
+    return nullptr;
+}
+
+std::string stripCompressionExtension(const std::string &path)
+{
+    for (const char *suffix : {".gz", ".zst"}) {
+        if (hasSuffix(path, suffix)) {
+            return path.substr(0, path.size() - std::strlen(suffix));
+        }
+    }
+    return path;
+}
+
+} // namespace vision
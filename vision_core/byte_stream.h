@@ -0,0 +1,93 @@
+#ifndef VISION_BYTE_STREAM_H
+#define VISION_BYTE_STREAM_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vision {
+
+enum class Compression {
+    None,
+    Gzip,
+    Zstd,
+};
+
+// 파일 앞부분의 매직 바이트로 판단 (확장자는 보지 않는다)
+Compression detectCompression(const unsigned char *data, std::size_t size);
+const char *compressionName(Compression compression);
+
+// 파일 앞 4 바이트만 읽어서 판단. 열지 못하면 None.
+Compression fileCompression(const std::string &path);
+
+// 압축 여부와 관계없이 앞에서부터 순서대로 읽는 바이트 입력
+class ByteStream
+{
+public:
+    virtual ~ByteStream() = default;
+
+    // 최대 size 바이트를 읽는다. 0 이면 끝이거나 오류 (error() 로 구분).
+    virtual std::size_t read(char *data, std::size_t size) = 0;
+
+    // 오류 메시지. 정상이면 빈 문자열.
+    virtual std::string error() const = 0;
+
+    // 원본 파일에서 지금까지 읽은 바이트 (압축 파일이면 압축된 크기 기준, 진행률용)
+    virtual std::size_t sourceBytesRead() const = 0;
+};
+
+// 다른 스트림을 백그라운드 스레드에서 미리 읽는다 (이중 버퍼).
+// 압축 해제가 한 스레드에서 도는 동안 호출한 쪽은 앞 블록을 파싱할 수 있다.
+class PrefetchByteStream : public ByteStream
+{
+public:
+    explicit PrefetchByteStream(std::unique_ptr<ByteStream> source,
+                                std::size_t blockBytes = 4 << 20);
+    ~PrefetchByteStream() override;
+
+    std::size_t read(char *data, std::size_t size) override;
+    std::string error() const override;
+    std::size_t sourceBytesRead() const override;
+
+private:
+    struct Block {
+        std::vector<char> data;
+        std::size_t size = 0;
+        bool ready = false;  // 채워져서 소비를 기다림
+        bool last = false;   // 이 블록 뒤로는 없음
+    };
+
+    void producerLoop();
+
+    std::unique_ptr<ByteStream> source;
+    Block blocks[2];
+    int consumerBlock = 0;        // 지금 읽는 블록
+    std::size_t consumerOffset = 0;
+    bool finished = false;
+    bool stopping = false;
+    std::string failure;
+    std::size_t sourceBytes = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable blockReady;
+    std::condition_variable blockFree;
+    std::thread producer;
+};
+
+// 파일을 열어 gzip / zstd 면 압축을 풀며 읽는 스트림을 만든다.
+// 압축된 파일은 PrefetchByteStream 으로 감싸서 해제를 별도 스레드에서 한다.
+// zstd 는 빌드할 때 라이브러리가 있어야 한다 (VISION_HAVE_ZSTD).
+std::unique_ptr<ByteStream> openByteStream(const std::string &path, std::string *error = nullptr,
+                                           Compression *compression = nullptr);
+
+// "a.csv.gz" -> "a.csv" (압축 확장자가 없으면 그대로)
+std::string stripCompressionExtension(const std::string &path);
+
+} // namespace vision
+
+#endif // VISION_BYTE_STREAM_H
@@ -0,0 +1,82 @@
+#include "cluster_eval.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace vision {
+
+namespace {
+
+// 라벨 값을 0부터 연속된 번호로 바꾼다
+std::vector<int> denseLabels(const int *labels, std::size_t count, int &classes)
+{
+    std::unordered_map<int, int> index;
+    std::vector<int> dense(count);
+    for (std::size_t i = 0; i < count; i++) {
+        auto inserted = index.emplace(labels[i], static_cast<int>(index.size()));
+        dense[i] = inserted.first->second;
+    }
+    classes = static_cast<int>(index.size());
+    return dense;
+}
+
+double pairs(double n)
+{
+    return n * (n - 1) / 2;
+}
+
+} // namespace
+
+ClusterAgreement compareClusterings(const int *truth, const int *predicted, std::size_t count)
+{
+    ClusterAgreement result;
+    result.points = count;
+    if (count == 0) {
+        return result;
+    }
+
+    const std::vector<int> t = denseLabels(truth, count, result.truthClusters);
+    const std::vector<int> p = denseLabels(predicted, count, result.predictedClusters);
+
+    // 분할표 (결과 클러스터 x 정답 라벨)
+    const int rows = result.predictedClusters;
+    const int columns = result.truthClusters;
+    std::vector<std::size_t> table(static_cast<std::size_t>(rows) * columns, 0);
+    for (std::size_t i = 0; i < count; i++) {
+        table[static_cast<std::size_t>(p[i]) * columns + t[i]]++;
+    }
+
+    std::vector<double> rowSums(rows, 0);
+    std::vector<double> columnSums(columns, 0);
+    std::size_t majority = 0;
+    double indexPairs = 0;
+    for (int r = 0; r < rows; r++) {
+        std::size_t best = 0;
+        for (int c = 0; c < columns; c++) {
+            const std::size_t n = table[static_cast<std::size_t>(r) * columns + c];
+            best = std::max(best, n);
+            rowSums[r] += n;
+            columnSums[c] += n;
+            indexPairs += pairs(static_cast<double>(n));
+        }
+        majority += best;
+    }
+    result.purity = static_cast<double>(majority) / count;
+
+    // Hubert & Arabie 의 ARI (점이 하나면 쌍이 없으므로 일치로 본다)
+    if (count < 2) {
+        result.adjustedRandIndex = 1.0;
+        return result;
+    }
+    double rowPairs = 0;
+    double columnPairs = 0;
+    for (double n : rowSums) rowPairs += pairs(n);
+    for (double n : columnSums) columnPairs += pairs(n);
+    const double expected = rowPairs * columnPairs / pairs(static_cast<double>(count));
+    const double maximum = (rowPairs + columnPairs) / 2;
+    result.adjustedRandIndex = maximum == expected ? 1.0 : (indexPairs - expected) / (maximum - expected);
+    return result;
+}
+
+} // namespace vision
@@ -0,0 +1,23 @@
+#ifndef VISION_CLUSTER_EVAL_H
+#define VISION_CLUSTER_EVAL_H
+
+#include <cstddef>
+
+namespace vision {
+
+// 정답 라벨과 클러스터링 결과의 일치도.
+// 클러스터 번호는 서로 대응시킬 필요가 없다 (번호를 바꿔도 값이 같다).
+struct ClusterAgreement {
+    std::size_t points = 0;
+    int truthClusters = 0;      // 정답 라벨 종류 수
+    int predictedClusters = 0;  // 결과 라벨 종류 수
+    double purity = 0;          // 클러스터마다 가장 많은 정답 라벨 비율의 가중 평균 (0~1)
+    double adjustedRandIndex = 0;  // 무작위 배정이면 0 근처, 완전히 같으면 1
+};
+
+// truth, predicted 는 count 개. 라벨 값은 아무 정수나 된다.
+ClusterAgreement compareClusterings(const int *truth, const int *predicted, std::size_t count);
+
+} // namespace vision
+
+#endif // VISION_CLUSTER_EVAL_H
@@ -0,0 +1,354 @@
+#include "column_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+#ifndef _WIN32
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <atomic>
+#include <functional>
+#include <thread>
+#endif
+
+namespace vision {
+
+namespace {
+
+std::uint64_t alignUp(std::uint64_t value)
+{
+    return (value + columnCacheAlignment - 1) / columnCacheAlignment * columnCacheAlignment;
+}
+
+bool writeBytes(std::FILE *file, const void *data, std::size_t size)
+{
+    return size == 0 || std::fwrite(data, 1, size, file) == size;
+}
+
+// path 옆에 겹치지 않는 임시 파일을 만든다. 같은 캐시를 동시에 만드는 쓰기들이
+// (매니페스트에 같은 CSV 가 두 번, 또는 다른 프로세스) 서로의 파일을 덮지 않게 한다.
+std::FILE *openTempFile(const std::string &path, std::string &tempPath)
+{
+#ifndef _WIN32
+    std::vector<char> name(path.begin(), path.end());
+    const char suffix[] = ".XXXXXX";
+    name.insert(name.end(), suffix, suffix + sizeof(suffix));
+    const int fd = ::mkstemp(name.data());
+    if (fd < 0) {
+        tempPath = path + suffix;
+        return nullptr;
+    }
+    tempPath = name.data();
+    // mkstemp 는 0600 으로 만든다. 다른 캐시 파일처럼 읽을 수 있게 한다.
+    ::fchmod(fd, 0644);
+    std::FILE *file = ::fdopen(fd, "wb");
+    if (!file) {
+        ::close(fd);
+        std::remove(tempPath.c_str());
+    }
+    return file;
+#else
+    static std::atomic<unsigned> counter{0};
+    const std::size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+    const auto tick = std::chrono::steady_clock::now().time_since_epoch().count();
+    tempPath = path + "." + std::to_string(thread) + "." + std::to_string(tick) + "." +
+               std::to_string(counter++) + ".tmp";
+    return std::fopen(tempPath.c_str(), "wbx");
+#endif
+}
+
+bool writePadding(std::FILE *file, std::uint64_t from, std::uint64_t to)
+{
+    static const char zeros[columnCacheAlignment] = {};
+    return writeBytes(file, zeros, static_cast<std::size_t>(to - from));
+}
+
+ColumnSummary summarizeLabels(const int *values, std::size_t count)
+{
+    ColumnSummary summary;
+    if (count == 0) {
+        return summary;
+    }
+
+    int min = values[0];
+    int max = values[0];
+    double sum = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        min = std::min(min, values[i]);
+        max = std::max(max, values[i]);
+        sum += values[i];
+    }
+    summary.min = min;
+    summary.max = max;
+    summary.mean = sum / static_cast<double>(count);
+    return summary;
+}
+
+} // namespace
+
+ColumnSummary summarizeColumn(const double *values, std::size_t count)
+{
+    ColumnSummary summary;
+    if (count == 0) {
+        return summary;
+    }
+
+    double min = values[0];
+    double max = values[0];
+    double sum = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        const double v = values[i];
+        if (v < min) min = v;
+        if (v > max) max = v;
+        sum += v;
+    }
+    summary.min = min;
+    summary.max = max;
+    summary.mean = sum / static_cast<double>(count);
+    return summary;
+}
+
+bool sourceInfo(const std::string &path, SourceInfo &info)
+{
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    const std::filesystem::file_time_type mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+
+    info.size = size;
+    info.mtime = static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count());
+    return true;
+}
+
+std::string columnCachePath(const std::string &csvPath)
+{
+    return csvPath + ".vcol";
+}
+
+bool writeColumnCache(const std::string &path, PointView points, const int *labels,
+                      const CsvOptions &options, const CsvStats &csvStats,
+                      const SourceInfo &source, std::string *error)
+{
+    ColumnCacheHeader header;
+    header.rows = points.size;
+    header.sourceSize = source.size;
+    header.sourceMtime = source.mtime;
+    header.skipHeader = options.skipHeader ? 1 : 0;
+    header.minColumns = options.minColumns;
+    header.maxColumns = options.maxColumns;
+    header.xColumn = options.xColumn;
+    header.yColumn = options.yColumn;
+    header.labelColumn = options.labelColumn;
+    header.csvRows = csvStats.rows;
+    header.rejectedRows = csvStats.rejectedRows;
+
+    // x, y (, 라벨) 열을 차례로 정렬된 위치에 배치
+    const void *columns[3] = {points.x, points.y, labels};
+    std::size_t columnBytes[3] = {points.size * sizeof(double), points.size * sizeof(double),
+                                  points.size * sizeof(int)};
+    header.columns = labels ? 3 : 2;
+    std::uint64_t offset = alignUp(sizeof(ColumnCacheHeader));
+    for (std::uint32_t c = 0; c < header.columns; c++) {
+        header.column[c].type = c < 2 ? ColumnType::Float64 : ColumnType::Int32;
+        header.column[c].offset = offset;
+        header.column[c].summary = c < 2 ? summarizeColumn(static_cast<const double *>(columns[c]), points.size)
+                                         : summarizeLabels(labels, points.size);
+        offset = alignUp(offset + columnBytes[c]);
+    }
+    header.rejectedLinesOffset = offset;
+    header.rejectedLineCount = csvStats.rejectedLines.size();
+
+    std::string tempPath;
+    std::FILE *file = openTempFile(path, tempPath);
+    if (!file) {
+        if (error) *error = "Cannot open file for writing: " + tempPath;
+        return false;
+    }
+
+    bool ok = writeBytes(file, &header, sizeof(header));
+    std::uint64_t written = sizeof(header);
+    for (std::uint32_t c = 0; c < header.columns && ok; c++) {
+        ok = writePadding(file, written, header.column[c].offset) &&
+             writeBytes(file, columns[c], columnBytes[c]);
+        written = header.column[c].offset + columnBytes[c];
+    }
+    if (ok) {
+        const std::vector<std::uint64_t> lines(csvStats.rejectedLines.begin(), csvStats.rejectedLines.end());
+        ok = writePadding(file, written, header.rejectedLinesOffset) &&
+             writeBytes(file, lines.data(), lines.size() * sizeof(std::uint64_t));
+    }
+    if (std::fflush(file) != 0) ok = false;
+    if (std::fclose(file) != 0) ok = false;
+
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        if (error) *error = "Cannot write column cache: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool ColumnCache::open(const std::string &path, std::string *error)
+{
+    close();
+
+    if (!file.open(path, error)) {
+        return false;
+    }
+
+    auto fail = [&](const char *reason) {
+        if (error) *error = std::string(reason) + ": " + path;
+        close();
+        return false;
+    };
+
+    const std::size_t fileSize = file.size();
+    if (fileSize < sizeof(ColumnCacheHeader)) {
+        return fail("Truncated column cache");
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, "VCOL", 4) != 0) {
+        return fail("Not a column cache");
+    }
+    if (header.version != 2 || header.headerSize != sizeof(ColumnCacheHeader) ||
+        header.columns < 2 || header.columns > 3) {
+        return fail("Unsupported column cache version");
+    }
+
+    // 열과 줄 번호 배열이 파일 안에 있는지 확인
+    const std::uint64_t maxRows = std::numeric_limits<std::uint64_t>::max() / sizeof(double);
+    if (header.rows > maxRows || header.rejectedLineCount > maxRows) {
+        return fail("Corrupt column cache");
+    }
+    for (std::uint32_t c = 0; c < header.columns; c++) {
+        const ColumnCacheColumn &column = header.column[c];
+        const ColumnType expected = c < 2 ? ColumnType::Float64 : ColumnType::Int32;
+        const std::size_t width = c < 2 ? sizeof(double) : sizeof(int);
+        if (column.type != expected || column.offset % columnCacheAlignment != 0 ||
+            column.offset > fileSize || header.rows * width > fileSize - column.offset) {
+            return fail("Corrupt column cache");
+        }
+    }
+    if (header.rejectedLinesOffset > fileSize ||
+        header.rejectedLineCount * sizeof(std::uint64_t) > fileSize - header.rejectedLinesOffset) {
+        return fail("Corrupt column cache");
+    }
+
+    x = reinterpret_cast<const double *>(file.data() + header.column[0].offset);
+    y = reinterpret_cast<const double *>(file.data() + header.column[1].offset);
+    if (header.columns > 2) {
+        labelValues = reinterpret_cast<const int *>(file.data() + header.column[2].offset);
+        summaries[2] = header.column[2].summary;
+    }
+    rejectedLines = reinterpret_cast<const std::uint64_t *>(file.data() + header.rejectedLinesOffset);
+    rows = static_cast<std::size_t>(header.rows);
+    summaries[0] = header.column[0].summary;
+    summaries[1] = header.column[1].summary;
+    opened = true;
+    return true;
+}
+
+void ColumnCache::close()
+{
+    file.close();
+    points.clear();
+    opened = false;
+    owned = false;
+    header = ColumnCacheHeader();
+    x = nullptr;
+    y = nullptr;
+    labelValues = nullptr;
+    rows = 0;
+    rejectedLines = nullptr;
+    ownedStats = CsvStats();
+}
+
+void ColumnCache::adopt(PointSet &&parsed, const CsvStats &csvStats)
+{
+    close();
+
+    points = std::move(parsed);
+    ownedStats = csvStats;
+    x = points.x.data();
+    y = points.y.data();
+    rows = points.size();
+    summaries[0] = summarizeColumn(x, rows);
+    summaries[1] = summarizeColumn(y, rows);
+    if (points.hasLabels()) {
+        labelValues = points.labels.data();
+        summaries[2] = summarizeLabels(labelValues, rows);
+    }
+    opened = true;
+    owned = true;
+}
+
+bool ColumnCache::matches(const SourceInfo &source, const CsvOptions &options) const
+{
+    return isMapped() &&
+           header.sourceSize == source.size &&
+           header.sourceMtime == source.mtime &&
+           header.skipHeader == (options.skipHeader ? 1 : 0) &&
+           header.minColumns == options.minColumns &&
+           header.maxColumns == options.maxColumns &&
+           header.xColumn == options.xColumn &&
+           header.yColumn == options.yColumn &&
+           header.labelColumn == options.labelColumn;
+}
+
+CsvStats ColumnCache::csvStats() const
+{
+    if (owned) {
+        return ownedStats;
+    }
+
+    CsvStats result;
+    result.rows = static_cast<std::size_t>(header.csvRows);
+    result.rejectedRows = static_cast<std::size_t>(header.rejectedRows);
+    result.rejectedLines.assign(rejectedLines, rejectedLines + header.rejectedLineCount);
+    return result;
+}
+
+bool loadCsvCached(const std::string &csvPath, const CsvOptions &options, ColumnCache &cache,
+                   std::string *error, Stats *stats)
+{
+    SourceInfo source;
+    if (!sourceInfo(csvPath, source)) {
+        if (error) *error = "Cannot open file for reading: " + csvPath;
+        return false;
+    }
+
+    const std::string cachePath = columnCachePath(csvPath);
+    {
+        VISION_STAT_TIMER(stats, Stage::Parse);
+        if (cache.open(cachePath) && cache.matches(source, options)) {
+            return true;
+        }
+    }
+
+    PointSet points;
+    CsvStats csvStats;
+    if (!loadCsvFile(csvPath, options, points, &csvStats, error, stats)) {
+        cache.close();
+        return false;
+    }
+
+    // 캐시를 쓰고 다시 매핑해서 이후와 같은 경로로 사용. 실패해도 로드는 성공.
+    const int *labels = points.hasLabels() ? points.labels.data() : nullptr;
+    if (writeColumnCache(cachePath, points.view(), labels, options, csvStats, source) &&
+        cache.open(cachePath) && cache.matches(source, options)) {
+        return true;
+    }
+    cache.adopt(std::move(points), csvStats);
+    return true;
+}
+
+} // namespace vision
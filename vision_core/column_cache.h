@@ -0,0 +1,137 @@
+#ifndef VISION_COLUMN_CACHE_H
+#define VISION_COLUMN_CACHE_H
+
+#include "csv_loader.h"
+#include "mapped_file.h"
+#include "point_set.h"
+#include "stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vision {
+
+// .vcol: 한 번 파싱한 CSV 의 열 캐시 (little endian).
+// 고정 크기 헤더 뒤에 열마다 64바이트 정렬된 배열(x, y, 있으면 라벨)이 오고, 마지막에 잘못된 행의
+// 줄 번호(uint64)가 온다. 파일을 그대로 매핑해서 PointView 로 쓰므로 다시 읽을 때
+// 파싱과 복사가 없다. 원본 크기/수정 시각과 파싱 옵션이 다르면 무효.
+enum class ColumnType : std::uint32_t {
+    Float64 = 1,
+    Int32 = 2,   // 정답 라벨
+};
+
+// 열 하나의 요약. 장면 범위나 임계값을 데이터를 다시 훑지 않고 정할 때 쓴다.
+struct ColumnSummary {
+    double min = 0;
+    double max = 0;
+    double mean = 0;
+};
+
+ColumnSummary summarizeColumn(const double *values, std::size_t count);
+
+const std::uint32_t columnCacheMaxColumns = 4;
+const std::size_t columnCacheAlignment = 64;
+
+struct ColumnCacheColumn {
+    ColumnType type = ColumnType::Float64;
+    std::uint32_t reserved = 0;
+    std::uint64_t offset = 0;  // 파일 시작 기준, columnCacheAlignment 배수
+    ColumnSummary summary;
+};
+
+struct ColumnCacheHeader {
+    char magic[4] = {'V', 'C', 'O', 'L'};
+    std::uint32_t version = 2;
+    std::uint32_t headerSize = sizeof(ColumnCacheHeader);
+    std::uint32_t columns = 2;  // x, y (라벨 열이 있으면 3)
+    std::uint64_t rows = 0;
+
+    // 원본 CSV 확인용
+    std::uint64_t sourceSize = 0;
+    std::int64_t sourceMtime = 0;
+
+    // 캐시를 만들 때의 CsvOptions
+    std::int32_t skipHeader = 0;
+    std::int32_t minColumns = 0;
+    std::int32_t maxColumns = 0;
+    std::int32_t xColumn = 0;
+    std::int32_t yColumn = 0;
+    std::int32_t labelColumn = -1;
+
+    // CsvStats
+    std::uint64_t csvRows = 0;
+    std::uint64_t rejectedRows = 0;
+    std::uint64_t rejectedLinesOffset = 0;
+    std::uint64_t rejectedLineCount = 0;
+
+    ColumnCacheColumn column[columnCacheMaxColumns];
+};
+static_assert(sizeof(ColumnCacheHeader) == 256, "ColumnCacheHeader layout");
+
+// 원본 파일의 크기와 수정 시각. 읽지 못하면 false.
+struct SourceInfo {
+    std::uint64_t size = 0;
+    std::int64_t mtime = 0;
+};
+
+bool sourceInfo(const std::string &path, SourceInfo &info);
+
+// data.csv -> data.csv.vcol
+std::string columnCachePath(const std::string &csvPath);
+
+// 임시 파일에 쓰고 rename 하므로 동시에 읽는 쪽은 완성된 파일만 본다.
+// labels 는 nullptr 이거나 points.size 개.
+bool writeColumnCache(const std::string &path, PointView points, const int *labels,
+                      const CsvOptions &options,
+                      const CsvStats &csvStats, const SourceInfo &source,
+                      std::string *error = nullptr);
+
+class ColumnCache
+{
+public:
+    ColumnCache() = default;
+
+    ColumnCache(const ColumnCache &) = delete;
+    ColumnCache &operator=(const ColumnCache &) = delete;
+
+    // 헤더와 크기가 올바른지만 확인한다 (원본과의 일치는 matches)
+    bool open(const std::string &path, std::string *error = nullptr);
+    void close();
+
+    // 캐시를 쓸 수 없을 때 파싱 결과를 그대로 들고 같은 인터페이스를 제공
+    void adopt(PointSet &&points, const CsvStats &csvStats);
+
+    bool matches(const SourceInfo &source, const CsvOptions &options) const;
+
+    bool isOpen() const { return opened; }
+    bool isMapped() const { return opened && !owned; }
+    std::size_t size() const { return rows; }
+    PointView view() const { return {x, y, rows}; }
+    const int *labels() const { return labelValues; }  // 라벨 열이 없으면 nullptr
+    const ColumnSummary &summary(int column) const { return summaries[column]; }
+    CsvStats csvStats() const;
+
+private:
+    MappedFile file;
+    PointSet points;  // adopt() 한 경우만
+    bool opened = false;
+    bool owned = false;
+    ColumnCacheHeader header;
+    const double *x = nullptr;
+    const double *y = nullptr;
+    const int *labelValues = nullptr;
+    std::size_t rows = 0;
+    ColumnSummary summaries[3];
+    const std::uint64_t *rejectedLines = nullptr;
+    CsvStats ownedStats;
+};
+
+// 캐시가 유효하면 매핑만 하고, 아니면 CSV 를 파싱해서 캐시를 새로 쓴 뒤 연다.
+// 캐시를 쓸 수 없는 위치(읽기 전용 등)면 파싱 결과를 그대로 cache 에 넣는다.
+bool loadCsvCached(const std::string &csvPath, const CsvOptions &options, ColumnCache &cache,
+                   std::string *error = nullptr, Stats *stats = nullptr);
+
+} // namespace vision
+
+#endif // VISION_COLUMN_CACHE_H
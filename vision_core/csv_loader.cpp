@@ -0,0 +1,332 @@
+#include "csv_loader.h"
+#include "byte_stream.h"
+#include "csv_scanner.h"
+#include "mapped_file.h"
+#include "number_parse.h"
+#include "point_source.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace vision {
+
+namespace {
+
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// 앞뒤 공백과 '+' 부호를 허용하고 필드 전체가 숫자일 때만 성공
+// (QString::toDouble 과 같은 규칙). 버퍼를 복사하지 않고 바로 변환한다.
+// 줄 끝의 '\r' 은 마지막 필드의 공백으로 처리된다.
+bool parseField(const char *begin, const char *end, double &value)
+{
+    while (begin < end && isBlank(*begin)) begin++;
+    while (end > begin && isBlank(end[-1])) end--;
+    if (begin < end && *begin == '+') begin++;
+    if (begin == end) return false;
+
+    return parseDouble(begin, end, value);
+}
+
+// 라벨은 정수만 허용 ("2", "+2", "2.0" 은 되고 "2.5" 는 안 됨)
+bool parseLabel(const char *begin, const char *end, int &label)
+{
+    double value;
+    if (!parseField(begin, end, value) || value != std::floor(value) ||
+        value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+        return false;
+    }
+    label = static_cast<int>(value);
+    return true;
+}
+
+// 앞/가운데/끝 세 곳의 줄 길이로 전체 행 수 추정
+std::size_t estimateRows(const char *data, std::size_t size)
+{
+    const std::size_t sample = 16 * 1024;
+    if (size <= sample * 3) {
+        return static_cast<std::size_t>(std::count(data, data + size, '\n')) + 1;
+    }
+
+    std::size_t lines = 0;
+    const std::size_t offsets[3] = {0, (size - sample) / 2, size - sample};
+    for (std::size_t offset : offsets) {
+        lines += static_cast<std::size_t>(std::count(data + offset, data + offset + sample, '\n'));
+    }
+    // 줄 길이가 조금 달라도 재할당이 한 번 이하가 되도록 10% 여유
+    return static_cast<std::size_t>(static_cast<double>(size) / (sample * 3) * lines * 1.1) + 1;
+}
+
+// 한 청크의 파싱 결과. 줄 번호는 청크 첫 줄을 0으로 센다.
+struct ChunkResult {
+    PointSet points;
+    std::size_t rows = 0;
+    std::size_t rejectedRows = 0;
+    std::vector<std::size_t> rejectedLines;
+    std::size_t bytes = 0;   // 실제로 읽은 바이트 (취소되면 size 보다 작음)
+    bool complete = false;
+};
+
+// 여러 청크가 함께 보고하는 진행률
+struct ParseProgress {
+    JobControl *control = nullptr;
+    std::size_t totalBytes = 0;
+    std::atomic<std::size_t> doneBytes{0};
+
+    // false 면 취소됨
+    bool update(std::size_t bytes)
+    {
+        if (!control) return true;
+        if (control->isCancelled()) return false;
+        const std::size_t done = doneBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        control->reportProgress(static_cast<double>(done) / totalBytes);
+        return true;
+    }
+};
+
+// 헤더가 없는 [data, data + size) 의 모든 줄을 파싱한다
+void parseLines(const char *data, std::size_t size, const CsvOptions &options,
+                ChunkResult &chunk, ParseProgress &progress)
+{
+    StructuralScanner scanner(data, size);
+    std::size_t lineStart = 0;
+
+    // 일부만 보고 행 수를 추정해 미리 할당 (전체를 한 번 더 훑지 않음)
+    const bool withLabels = options.labelColumn >= 0;
+    const std::size_t estimate = estimateRows(data, size);
+    chunk.points.reserve(estimate);
+    if (withLabels) chunk.points.labels.reserve(estimate);
+
+    // 취소/진행률은 1MB 마다 확인
+    const std::size_t checkInterval = 1 << 20;
+    std::size_t lastCheck = 0;
+    bool cancelled = false;
+
+    // 구분자 위치만 차례로 받아 필드를 자른다 (문자 단위 분기 없음)
+    while (lineStart < size) {
+        if (lineStart - lastCheck >= checkInterval) {
+            if (!progress.update(lineStart - lastCheck)) {
+                cancelled = true;
+                break;
+            }
+            lastCheck = lineStart;
+        }
+
+        const char *fieldBegin[3] = {nullptr, nullptr, nullptr};
+        const char *fieldEnd[3] = {nullptr, nullptr, nullptr};
+        int column = 0;
+        std::size_t start = lineStart;
+        std::size_t pos;
+        for (;;) {
+            pos = scanner.next();
+            if (column == options.xColumn) { fieldBegin[0] = data + start; fieldEnd[0] = data + pos; }
+            if (column == options.yColumn) { fieldBegin[1] = data + start; fieldEnd[1] = data + pos; }
+            if (column == options.labelColumn) { fieldBegin[2] = data + start; fieldEnd[2] = data + pos; }
+            column++;
+            start = pos + 1;
+            if (pos == size || data[pos] == '\n') break;
+        }
+
+        double x = 0, y = 0;
+        int label = 0;
+        const bool columnsOk = column >= options.minColumns &&
+                               (options.maxColumns < 0 || column <= options.maxColumns);
+        if (columnsOk && fieldBegin[0] && fieldBegin[1] &&
+            parseField(fieldBegin[0], fieldEnd[0], x) &&
+            parseField(fieldBegin[1], fieldEnd[1], y) &&
+            (!withLabels || (fieldBegin[2] && parseLabel(fieldBegin[2], fieldEnd[2], label)))) {
+            chunk.points.append(x, y);
+            if (withLabels) chunk.points.labels.push_back(label);
+        } else {
+            if (chunk.rejectedLines.size() < options.maxRejectedLines) {
+                chunk.rejectedLines.push_back(chunk.rows);
+            }
+            chunk.rejectedRows++;
+        }
+        chunk.rows++;
+
+        lineStart = pos + 1;
+    }
+
+    chunk.bytes = std::min(lineStart, size);
+    chunk.complete = !cancelled;
+}
+
+// 청크를 이어 붙일 때 쓰는 위치 정보
+struct ChunkRange {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+
+// [begin, size) 를 약 count 개로 나누되 경계는 항상 줄의 시작
+std::vector<ChunkRange> splitLines(const char *data, std::size_t begin, std::size_t size,
+                                   std::size_t count)
+{
+    std::vector<ChunkRange> ranges;
+    const std::size_t step = (size - begin) / count;
+    std::size_t start = begin;
+    for (std::size_t i = 1; i < count && start < size; i++) {
+        std::size_t cut = std::max(start, begin + step * i);
+        const char *newline = static_cast<const char *>(std::memchr(data + cut, '\n', size - cut));
+        if (!newline) break;
+        cut = static_cast<std::size_t>(newline - data) + 1;
+        ranges.push_back({start, cut});
+        start = cut;
+    }
+    if (start < size) {
+        ranges.push_back({start, size});
+    }
+    return ranges;
+}
+
+// 청크가 이보다 작으면 스레드를 나누지 않는다
+const std::size_t minChunkBytes = 1 << 20;
+
+} // namespace
+
+CsvStats parseCsv(const char *data, std::size_t size, const CsvOptions &options, PointSet &out,
+                  JobControl *control, Stats *stats)
+{
+    VISION_STAT_TIMER(stats, Stage::Parse);
+
+    // 헤더는 청크로 나누기 전에 한 번만 건너뛴다
+    std::size_t bodyStart = 0;
+    std::size_t firstLine = 1;
+    if (options.skipHeader) {
+        const char *newline = static_cast<const char *>(std::memchr(data, '\n', size));
+        bodyStart = newline ? static_cast<std::size_t>(newline - data) + 1 : size;
+        firstLine = 2;
+    }
+
+    unsigned threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::size_t chunkCount =
+        std::max<std::size_t>(1, std::min<std::size_t>(threads, (size - bodyStart) / minChunkBytes));
+
+    const std::vector<ChunkRange> ranges = splitLines(data, bodyStart, size, chunkCount);
+    std::vector<ChunkResult> chunks(ranges.size());
+
+    ParseProgress progress;
+    progress.control = control;
+    progress.totalBytes = size;
+
+    // 청크마다 독립된 버퍼에 파싱
+    auto parseChunk = [&](std::size_t i) {
+        parseLines(data + ranges[i].begin, ranges[i].end - ranges[i].begin, options, chunks[i],
+                   progress);
+    };
+    std::unique_ptr<ThreadPool> pool;
+    if (chunks.size() > 1) {
+        pool.reset(new ThreadPool(static_cast<unsigned>(chunks.size()), chunks.size()));
+        for (std::size_t i = 0; i < chunks.size(); i++) {
+            pool->submit([&parseChunk, i] { parseChunk(i); });
+        }
+        pool->wait();
+    } else if (!chunks.empty()) {
+        parseChunk(0);
+    }
+
+    // 원래 행 순서대로 합친다. 취소된 경우 처음으로 끝나지 못한 청크까지만.
+    CsvStats result;
+    std::size_t usedChunks = 0;
+    std::size_t pointCount = 0;
+    std::size_t bytes = bodyStart;
+    std::size_t line = firstLine;
+    std::vector<std::size_t> offsets;
+    offsets.reserve(chunks.size());
+    for (const ChunkResult &chunk : chunks) {
+        offsets.push_back(out.size() + pointCount);
+        pointCount += chunk.points.size();
+        result.rows += chunk.rows;
+        result.rejectedRows += chunk.rejectedRows;
+        for (std::size_t local : chunk.rejectedLines) {
+            if (result.rejectedLines.size() >= options.maxRejectedLines) break;
+            result.rejectedLines.push_back(line + local);
+        }
+        line += chunk.rows;
+        bytes += chunk.bytes;
+        usedChunks++;
+        if (!chunk.complete) break;
+    }
+
+    if (usedChunks == 1 && out.empty()) {
+        out = std::move(chunks[0].points);
+    } else {
+        const bool withLabels = options.labelColumn >= 0;
+        out.x.resize(out.size() + pointCount);
+        out.y.resize(out.y.size() + pointCount);
+        if (withLabels) out.labels.resize(out.x.size());
+        auto copyChunk = [&](std::size_t i) {
+            const PointSet &points = chunks[i].points;
+            std::copy(points.x.begin(), points.x.end(), out.x.begin() + offsets[i]);
+            std::copy(points.y.begin(), points.y.end(), out.y.begin() + offsets[i]);
+            if (withLabels) {
+                std::copy(points.labels.begin(), points.labels.end(), out.labels.begin() + offsets[i]);
+            }
+        };
+        if (pool) {
+            for (std::size_t i = 0; i < usedChunks; i++) {
+                pool->submit([&copyChunk, i] { copyChunk(i); });
+            }
+            pool->wait();
+        } else {
+            for (std::size_t i = 0; i < usedChunks; i++) {
+                copyChunk(i);
+            }
+        }
+    }
+
+    VISION_STAT_ADD(stats, bytesParsed, bytes);
+    VISION_STAT_ADD(stats, rowsParsed, result.rows);
+    VISION_STAT_ADD(stats, rowsRejected, result.rejectedRows);
+    return result;
+}
+
+bool loadCsvFile(const std::string &path, const CsvOptions &options, PointSet &out,
+                 CsvStats *csvStats, std::string *error, Stats *stats)
+{
+    if (fileCompression(path) != Compression::None) {
+        // 압축 파일: 압축 해제 스레드가 다음 블록을 푸는 동안 앞 블록을 파싱
+        CsvChunkSource source(options);
+        if (!source.open(path, error)) {
+            return false;
+        }
+        PointSet chunk;
+        {
+            VISION_STAT_TIMER(stats, Stage::Parse);
+            while (source.next(chunk)) {
+                out.append(chunk);
+            }
+        }
+        if (!source.error().empty()) {
+            if (error) *error = source.error();
+            return false;
+        }
+        VISION_STAT_ADD(stats, bytesParsed, source.bytesRead());
+        VISION_STAT_ADD(stats, rowsParsed, source.csvStats().rows);
+        VISION_STAT_ADD(stats, rowsRejected, source.csvStats().rejectedRows);
+        if (csvStats) *csvStats = source.csvStats();
+        return true;
+    }
+
+    MappedFile file;
+    if (!file.open(path, error)) {
+        return false;
+    }
+
+    const CsvStats parsed = parseCsv(file.data(), file.size(), options, out, nullptr, stats);
+    if (csvStats) *csvStats = parsed;
+    return true;
+}
+
+} // namespace vision
@@ -0,0 +1,46 @@
+#ifndef VISION_CSV_LOADER_H
+#define VISION_CSV_LOADER_H
+
+#include "job_control.h"
+#include "point_set.h"
+#include "stats.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+struct CsvOptions {
+    bool skipHeader = true;  // 첫 줄은 헤더
+    int minColumns = 2;      // 열 개수가 이 범위를 벗어난 행은 건너뜀
+    int maxColumns = 2;      // -1이면 제한 없음 (x, y, label 처럼 추가 열 허용)
+    int xColumn = 0;
+    int yColumn = 1;
+    int labelColumn = -1;    // 정답 라벨(정수) 열. 0 이상이면 PointSet::labels 에 같이 읽는다
+    unsigned threads = 0;                // 파싱 스레드 수. 0이면 hardware_concurrency
+    std::size_t maxRejectedLines = 100;  // CsvStats::rejectedLines 에 남길 최대 개수
+};
+
+struct CsvStats {
+    std::size_t rows = 0;          // 헤더를 제외한 행 수
+    std::size_t rejectedRows = 0;  // 열 개수나 숫자 변환이 잘못된 행
+    std::vector<std::size_t> rejectedLines;  // 잘못된 행의 줄 번호 (1부터, 앞쪽 일부만)
+};
+
+// 메모리에 올라온 CSV 텍스트를 파싱해 out 뒤에 추가한다.
+// 큰 입력은 줄 경계에서 청크로 나눠 여러 스레드가 청크별 버퍼에 파싱한 뒤
+// 원래 행 순서대로 이어 붙인다. 결과는 스레드 수와 관계없이 같다.
+// control 이 취소되면 앞에서부터 끊김 없이 읽은 행만 남긴다.
+CsvStats parseCsv(const char *data, std::size_t size, const CsvOptions &options, PointSet &out,
+                  JobControl *control = nullptr, Stats *stats = nullptr);
+
+// 파일을 매핑(mmap)해서 복사 없이 파싱. 열지 못하면 false 와 error 메시지.
+// gzip / zstd 파일(매직 바이트로 판단)은 압축을 풀면서 블록 단위로 파싱한다.
+bool loadCsvFile(const std::string &path, const CsvOptions &options, PointSet &out,
+                 CsvStats *csvStats = nullptr, std::string *error = nullptr,
+                 Stats *stats = nullptr);
+
+} // namespace vision
+
+#endif // VISION_CSV_LOADER_H
@@ -0,0 +1,124 @@
+#include "csv_scanner.h"
+
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VISION_SCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace vision {
+
+namespace {
+
+inline bool isStructural(char c)
+{
+    return c == ',' || c == '\n';
+}
+
+// 64바이트 미만 꼬리 블록용
+std::uint64_t scalarMask(const char *p, std::size_t length)
+{
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < length; i++) {
+        mask |= static_cast<std::uint64_t>(isStructural(p[i])) << i;
+    }
+    return mask;
+}
+
+void scalarKernel(const char *p, std::size_t blocks, std::uint64_t *masks)
+{
+    for (std::size_t b = 0; b < blocks; b++) {
+        masks[b] = scalarMask(p + b * 64, 64);
+    }
+}
+
+#ifdef VISION_SCANNER_X86
+
+__attribute__((target("sse2")))
+void sse2Kernel(const char *p, std::size_t blocks, std::uint64_t *masks)
+{
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    for (std::size_t b = 0; b < blocks; b++) {
+        std::uint64_t mask = 0;
+        for (int i = 0; i < 4; i++) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + b * 64 + i * 16));
+            const __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, newline));
+            mask |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(hit))) << (i * 16);
+        }
+        masks[b] = mask;
+    }
+}
+
+__attribute__((target("avx2")))
+void avx2Kernel(const char *p, std::size_t blocks, std::uint64_t *masks)
+{
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    for (std::size_t b = 0; b < blocks; b++) {
+        const char *block = p + b * 64;
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+        const __m256i hitLo = _mm256_or_si256(_mm256_cmpeq_epi8(lo, comma), _mm256_cmpeq_epi8(lo, newline));
+        const __m256i hitHi = _mm256_or_si256(_mm256_cmpeq_epi8(hi, comma), _mm256_cmpeq_epi8(hi, newline));
+        const std::uint32_t maskLo = static_cast<std::uint32_t>(_mm256_movemask_epi8(hitLo));
+        const std::uint32_t maskHi = static_cast<std::uint32_t>(_mm256_movemask_epi8(hitHi));
+        masks[b] = maskLo | (static_cast<std::uint64_t>(maskHi) << 32);
+    }
+}
+
+#endif
+
+StructuralScanner::MaskKernel selectKernel(SimdLevel level)
+{
+#ifdef VISION_SCANNER_X86
+    // 이 용도에는 AVX-512 이득이 작아서 AVX2 커널을 쓴다
+    if (level >= SimdLevel::AVX2) return avx2Kernel;
+    if (level >= SimdLevel::SSE2) return sse2Kernel;
+#else
+    (void)level;
+#endif
+    return scalarKernel;
+}
+
+} // namespace
+
+StructuralScanner::StructuralScanner(const char *data, std::size_t size, SimdLevel level)
+    : data(data)
+    , size(size)
+    , kernel(selectKernel(level))
+{
+}
+
+bool StructuralScanner::advance()
+{
+    if (++blockIndex >= blockCount) {
+        if (nextChunk >= size) {
+            return false;
+        }
+
+        const std::size_t remaining = size - nextChunk;
+        const std::size_t fullBlocks = std::min<std::size_t>(remaining / 64, chunkBlocks);
+        chunkBase = nextChunk;
+        if (fullBlocks > 0) {
+            kernel(data + nextChunk, fullBlocks, masks);
+            blockCount = static_cast<int>(fullBlocks);
+            nextChunk += fullBlocks * 64;
+        } else {
+            // 끝에서 64바이트 미만은 범위를 넘어 읽지 않도록 스칼라로
+            masks[0] = scalarMask(data + nextChunk, remaining);
+            blockCount = 1;
+            nextChunk = size;
+        }
+        blockIndex = 0;
+    }
+
+    blockBase = chunkBase + static_cast<std::size_t>(blockIndex) * 64;
+    mask = masks[blockIndex];
+    return true;
+}
+
+} // namespace vision
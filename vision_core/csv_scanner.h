@@ -0,0 +1,67 @@
+#ifndef VISION_CSV_SCANNER_H
+#define VISION_CSV_SCANNER_H
+
+#include "simd.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vision {
+
+// 64바이트 블록마다 ',' 와 '\n' 위치를 비트마스크로 만들어 (simdjson 방식)
+// 구분자 위치를 차례로 돌려준다. 마스크는 4KB 단위로 한 번에 계산한다.
+class StructuralScanner
+{
+public:
+    // level 은 보통 simdLevel(). CPU 가 지원하지 않는 수준을 주면 안 된다.
+    StructuralScanner(const char *data, std::size_t size, SimdLevel level = simdLevel());
+
+    // 다음 ',' 또는 '\n' 의 위치. 더 없으면 size.
+    std::size_t next()
+    {
+        while (mask == 0) {
+            if (!advance()) return size;
+        }
+        const std::size_t pos = blockBase + countTrailingZeros(mask);
+        mask &= mask - 1;
+        return pos;
+    }
+
+    // n 블록(64 * n 바이트)의 마스크 계산
+    using MaskKernel = void (*)(const char *p, std::size_t blocks, std::uint64_t *masks);
+
+private:
+    static const int chunkBlocks = 64;
+
+    static unsigned countTrailingZeros(std::uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+        unsigned n = 0;
+        while (!(value & 1)) {
+            value >>= 1;
+            n++;
+        }
+        return n;
+#endif
+    }
+
+    bool advance();
+
+    const char *data;
+    std::size_t size;
+    MaskKernel kernel;
+
+    std::size_t nextChunk = 0;   // 아직 마스크를 만들지 않은 위치
+    std::size_t chunkBase = 0;   // masks[0] 의 시작 위치
+    std::size_t blockBase = 0;   // 현재 mask 의 시작 위치
+    int blockIndex = 0;
+    int blockCount = 0;
+    std::uint64_t mask = 0;
+    std::uint64_t masks[chunkBlocks];
+};
+
+} // namespace vision
+
+#endif // VISION_CSV_SCANNER_H
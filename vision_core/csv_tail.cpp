@@ -0,0 +1,114 @@
+#include "csv_tail.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace vision {
+
+bool CsvTail::statFile(const std::string &path, FileIdentity &identity, std::uint64_t &size)
+{
+#ifndef _WIN32
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    identity.device = static_cast<std::uint64_t>(info.st_dev);
+    identity.inode = static_cast<std::uint64_t>(info.st_ino);
+    identity.mtime = static_cast<std::int64_t>(info.st_mtime);
+    size = static_cast<std::uint64_t>(info.st_size);
+    return true;
+#else
+    // inode 가 없으므로 수정 시각이 뒤로 간 경우만 교체로 본다
+    std::error_code ec;
+    size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    const auto written = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    identity = FileIdentity();
+    identity.mtime = static_cast<std::int64_t>(written.time_since_epoch().count());
+    return true;
+#endif
+}
+
+void CsvTail::open(const std::string &path, const CsvOptions &options)
+{
+    filePath = path;
+    this->options = options;
+    reset();
+}
+
+void CsvTail::reset()
+{
+    readOffset = 0;
+    pending.clear();
+    lineNumber = 1;
+    headerPending = options.skipHeader;
+    identityKnown = false;
+    stats = CsvStats();
+}
+
+CsvTail::PollStatus CsvTail::poll(PointSet &out, std::string *error)
+{
+    FileIdentity current;
+    std::uint64_t size = 0;
+    if (!statFile(filePath, current, size)) {
+        if (error) *error = "Cannot open file for reading: " + filePath;
+        return PollStatus::Error;
+    }
+    // 줄었거나, 같은 경로에 다른 파일이 있거나, 수정 시각이 뒤로 갔으면 교체된 것.
+    // 교체된 파일이 더 길면 크기만으로는 알 수 없고 이전 offset 의 줄 중간부터 읽게 된다.
+    if (size < readOffset ||
+        (identityKnown && (current.device != identity.device || current.inode != identity.inode ||
+                           current.mtime < identity.mtime))) {
+        return PollStatus::Truncated;
+    }
+    identity = current;
+    identityKnown = true;
+    if (size == readOffset) {
+        return PollStatus::NoChange;
+    }
+
+    // 새로 붙은 부분만 보류 중인 줄 뒤에 읽는다
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file || !file.seekg(static_cast<std::streamoff>(readOffset))) {
+        if (error) *error = "Cannot open file for reading: " + filePath;
+        return PollStatus::Error;
+    }
+    const std::size_t kept = pending.size();
+    const std::size_t added = static_cast<std::size_t>(size - readOffset);
+    pending.resize(kept + added);
+    file.read(pending.data() + kept, static_cast<std::streamsize>(added));
+    const std::size_t got = static_cast<std::size_t>(file.gcount());
+    pending.resize(kept + got);
+    readOffset += got;
+
+    // 마지막 줄바꿈까지만 파싱
+    const auto lastNewline = std::find(pending.rbegin(), pending.rend(), '\n');
+    if (lastNewline == pending.rend()) {
+        return PollStatus::Appended;
+    }
+    const std::size_t end = static_cast<std::size_t>(pending.rend() - lastNewline);
+
+    CsvOptions blockOptions = options;
+    blockOptions.skipHeader = headerPending;
+    const CsvStats block = parseCsv(pending.data(), end, blockOptions, out);
+
+    for (std::size_t line : block.rejectedLines) {
+        if (stats.rejectedLines.size() >= options.maxRejectedLines) break;
+        stats.rejectedLines.push_back(lineNumber - 1 + line);
+    }
+    stats.rows += block.rows;
+    stats.rejectedRows += block.rejectedRows;
+    lineNumber += block.rows + (headerPending ? 1 : 0);
+    headerPending = false;
+
+    pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(end));
+    return PollStatus::Appended;
+}
+
+} // namespace vision
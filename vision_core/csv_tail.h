@@ -0,0 +1,62 @@
+#ifndef VISION_CSV_TAIL_H
+#define VISION_CSV_TAIL_H
+
+#include "csv_loader.h"
+#include "point_set.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+// 뒤에 행이 계속 추가되는 CSV 를 따라가며 (tail -f) 새로 붙은 바이트만 파싱한다.
+// 줄바꿈으로 끝나지 않은 마지막 줄은 쓰는 중일 수 있으므로 다음 poll 까지 보류한다.
+class CsvTail
+{
+public:
+    enum class PollStatus {
+        NoChange,   // 새 데이터 없음
+        Appended,   // 새 줄을 파싱함 (유효한 행이 없을 수도 있다)
+        Truncated,  // 파일이 줄었거나 다른 파일로 교체됐다. reset 후 처음부터 다시 읽어야 한다.
+        Error,
+    };
+
+    CsvTail() = default;
+
+    void open(const std::string &path, const CsvOptions &options = CsvOptions());
+    void reset();
+
+    // 새로 완성된 줄의 점을 out 뒤에 추가
+    PollStatus poll(PointSet &out, std::string *error = nullptr);
+
+    const std::string &path() const { return filePath; }
+    std::uint64_t offset() const { return readOffset; }
+
+    // 처음부터 지금까지 파싱한 행 통계 (줄 번호는 파일 기준)
+    const CsvStats &csvStats() const { return stats; }
+
+private:
+    // 같은 경로에 다른 파일이 들어왔는지 (logrotate, 임시 파일 후 rename) 알기 위한 값
+    struct FileIdentity {
+        std::uint64_t device = 0;
+        std::uint64_t inode = 0;
+        std::int64_t mtime = 0;
+    };
+    static bool statFile(const std::string &path, FileIdentity &identity, std::uint64_t &size);
+
+    CsvOptions options;
+    std::string filePath;
+    std::uint64_t readOffset = 0;  // 파일에서 읽은 바이트 (보류 중인 줄 포함)
+    std::vector<char> pending;     // 아직 끝나지 않은 줄
+    std::size_t lineNumber = 1;    // pending 첫 줄의 줄 번호
+    bool headerPending = true;
+    bool identityKnown = false;    // 처음 poll 에서 identity 를 기록
+    FileIdentity identity;
+    CsvStats stats;
+};
+
+} // namespace vision
+
+#endif // VISION_CSV_TAIL_H
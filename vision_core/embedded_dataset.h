@@ -0,0 +1,51 @@
+#ifndef VISION_EMBEDDED_DATASET_H
+#define VISION_EMBEDDED_DATASET_H
+
+#include "csv_loader.h"
+#include "point_set.h"
+
+#include <cstddef>
+
+namespace vision {
+
+// 빌드할 때 vision_embed 가 CSV 를 파싱해서 만든 정적 배열 (vision_embed_csv).
+// 실행할 때는 파싱 없이 그대로 쓰거나 PointSet 으로 복사만 한다.
+// 행 통계와 잘못된 행 줄 번호도 파싱 결과 그대로 들어 있다.
+struct EmbeddedDataset {
+    const char *source;       // 원본 CSV 파일 이름
+    const double *x;
+    const double *y;
+    const int *labels;        // 라벨 열 없이 만들었으면 nullptr
+    std::size_t size;
+    std::size_t csvRows;
+    std::size_t rejectedRows;
+    const std::size_t *rejectedLines;
+    std::size_t rejectedLineCount;
+
+    PointView view() const { return PointView{x, y, size}; }
+
+    CsvStats csvStats() const
+    {
+        CsvStats stats;
+        stats.rows = csvRows;
+        stats.rejectedRows = rejectedRows;
+        stats.rejectedLines.assign(rejectedLines, rejectedLines + rejectedLineCount);
+        return stats;
+    }
+
+    // 앱처럼 좌표를 바꿔 쓰는 경우 (out 의 기존 점은 지운다)
+    void copyTo(PointSet &out) const
+    {
+        out.x.assign(x, x + size);
+        out.y.assign(y, y + size);
+        if (labels) {
+            out.labels.assign(labels, labels + size);
+        } else {
+            out.labels.clear();
+        }
+    }
+};
+
+} // namespace vision
+
+#endif // VISION_EMBEDDED_DATASET_H
@@ -0,0 +1,206 @@
+#include "incremental.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vision {
+
+namespace {
+
+// 이미 처리한 first 개를 뺀 뒷부분
+PointView tailOf(const PointView &points, std::size_t first)
+{
+    return PointView{points.x + first, points.y + first, points.size - first};
+}
+
+} // namespace
+
+void IncrementalLineFit::update(const PointView &points)
+{
+    for (std::size_t i = processed; i < points.size; i++) {
+        moments.add(points.x[i], points.y[i]);
+    }
+    processed = std::max(processed, points.size);
+}
+
+void IncrementalLineFit::reset()
+{
+    moments = LineMoments();
+    processed = 0;
+}
+
+IncrementalRansac::IncrementalRansac(const RansacParams &params, std::size_t sampleSize)
+    : params(params)
+    , sampleSize(sampleSize)
+    , sampler(sampleSize, params.seed)
+    , gen(params.seed)
+{
+}
+
+void IncrementalRansac::reset()
+{
+    sampler = ReservoirSampler(sampleSize, params.seed);
+    gen.seed(params.seed);
+    hasHypothesis = false;
+    hypothesis = LineModel();
+    inlierMoments = LineMoments();
+    current = RansacResult();
+    processed = 0;
+}
+
+std::size_t IncrementalRansac::sampleScore(const LineModel &line) const
+{
+    return countInliers(sampler.sample().view(), line, params.threshold);
+}
+
+void IncrementalRansac::recount(const PointView &points, const LineModel &line, Stats *stats)
+{
+    VISION_STAT_TIMER(stats, Stage::Refit);
+    VISION_STAT_ADD(stats, modelRefits, 1);
+    VISION_STAT_ADD(stats, inlierTests, points.size);
+
+    hypothesis = line;
+    hasHypothesis = true;
+    inlierMoments = LineMoments();
+    collectInliers(points, line, params.threshold, current.inliers);
+    for (std::size_t i : current.inliers) {
+        inlierMoments.add(points.x[i], points.y[i]);
+    }
+    current.model = inlierMoments.solve();
+}
+
+bool IncrementalRansac::update(const PointView &points, Stats *stats)
+{
+    if (points.size <= processed) {
+        return false;
+    }
+    const std::size_t first = processed;
+    const std::size_t added = points.size - first;
+    processed = points.size;
+    sampler.add(tailOf(points, first));
+
+    // 처음에는 가진 점 전체로 일반 RANSAC 을 한 번 돌린다
+    if (!hasHypothesis) {
+        if (points.size < 2) {
+            return false;
+        }
+        const RansacResult initial = ransac(points, params, nullptr, stats);
+        current.iterations = initial.iterations;
+        if (initial.inliers.empty()) {
+            return false;
+        }
+        recount(points, initial.model, stats);
+        return true;
+    }
+
+    // 1. 새 점을 현재 가설로 판정 (새 점 수에 비례)
+    VISION_STAT_ADD(stats, inlierTests, added);
+    collectInliers(tailOf(points, first), hypothesis, params.threshold, addedInliers);
+    for (std::size_t i : addedInliers) {
+        current.inliers.push_back(first + i);
+        inlierMoments.add(points.x[first + i], points.y[first + i]);
+    }
+    current.model = inlierMoments.solve();
+
+    // 2. 새 점을 포함한 가설을 추가된 비율만큼 시도 (최소 1개)
+    VISION_STAT_TIMER(stats, Stage::Ransac);
+    const double share = static_cast<double>(added) / static_cast<double>(points.size);
+    const int budget = std::max(1, static_cast<int>(std::ceil(params.iterations * share)));
+    std::uniform_int_distribution<std::size_t> pickNew(first, points.size - 1);
+    std::uniform_int_distribution<std::size_t> pickAny(0, points.size - 1);
+
+    const std::size_t currentScore = sampleScore(hypothesis);
+    std::size_t bestScore = currentScore;
+    LineModel bestLine;
+    for (int iter = 0; iter < budget; iter++) {
+        current.iterations++;
+        VISION_STAT_ADD(stats, hypothesesGenerated, 1);
+
+        const std::size_t idx1 = pickNew(gen);
+        const std::size_t idx2 = pickAny(gen);
+        const double x1 = points.x[idx1], y1 = points.y[idx1];
+        const double x2 = points.x[idx2], y2 = points.y[idx2];
+        if (idx1 == idx2 || std::abs(x2 - x1) < 0.0001) {
+            VISION_STAT_ADD(stats, hypothesesDegenerate, 1);
+            continue;
+        }
+
+        LineModel line;
+        line.a = (y2 - y1) / (x2 - x1);
+        line.b = y1 - line.a * x1;
+
+        VISION_STAT_ADD(stats, hypothesesEvaluated, 1);
+        VISION_STAT_ADD(stats, inlierTests, sampler.sample().size());
+        const std::size_t score = sampleScore(line);
+        if (score > bestScore) {
+            bestScore = score;
+            bestLine = line;
+        }
+    }
+    if (bestScore == currentScore) {
+        return false;
+    }
+
+    // 3. 표본에서 이긴 가설만 전체로 다시 세어 확인
+    VISION_STAT_ADD(stats, inlierTests, points.size);
+    const std::size_t count = countInliers(points, bestLine, params.threshold);
+    if (count <= current.inliers.size()) {
+        return false;
+    }
+    recount(points, bestLine, stats);
+    return true;
+}
+
+IncrementalKMeans::IncrementalKMeans(const KMeansParams &params)
+    : params(params)
+{
+}
+
+void IncrementalKMeans::reset()
+{
+    current = KMeansResult();
+    counts.clear();
+    processed = 0;
+}
+
+void IncrementalKMeans::update(const PointView &points, Stats *stats)
+{
+    if (points.size <= processed || params.k <= 0) {
+        return;
+    }
+
+    // 시작은 일반 kmeans
+    if (current.centroids.empty()) {
+        if (points.size < static_cast<std::size_t>(params.k)) {
+            return;
+        }
+        current = kmeans(points, params, nullptr, stats);
+        counts.assign(current.centroids.size(), 0);
+        for (int label : current.labels) {
+            if (label >= 0) counts[label]++;
+        }
+        processed = points.size;
+        return;
+    }
+
+    VISION_STAT_TIMER(stats, Stage::KMeansAssign);
+    const std::size_t first = processed;
+    current.labels.resize(points.size, -1);
+    assignClusters(tailOf(points, first), current.centroids, current.labels.data() + first);
+
+    for (std::size_t i = first; i < points.size; i++) {
+        const int c = current.labels[i];
+        Centroid &centroid = current.centroids[c];
+        const double dx = points.x[i] - centroid.x;
+        const double dy = points.y[i] - centroid.y;
+        current.wss += dx * dx + dy * dy;
+
+        counts[c]++;
+        const double rate = 1.0 / static_cast<double>(counts[c]);
+        centroid.x += dx * rate;
+        centroid.y += dy * rate;
+    }
+    processed = points.size;
+}
+
+} // namespace vision
@@ -0,0 +1,90 @@
+#ifndef VISION_INCREMENTAL_H
+#define VISION_INCREMENTAL_H
+
+#include "kmeans.h"
+#include "line_fit.h"
+#include "point_set.h"
+#include "ransac.h"
+#include "stats.h"
+#include "streaming.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace vision {
+
+// 점이 뒤에 계속 추가될 때(팔로우 모드) 모델을 갱신하는 클래스들.
+// update() 에는 지금까지의 전체 점을 넘기고, 이전 호출 이후 추가된 점만 처리한다.
+// 한 번의 갱신 비용은 새 점 수에 비례한다.
+
+class IncrementalLineFit
+{
+public:
+    void update(const PointView &points);
+    void reset();
+
+    LineModel model() const { return moments.solve(); }
+    const LineMoments &lineMoments() const { return moments; }
+
+private:
+    LineMoments moments;
+    std::size_t processed = 0;
+};
+
+// 현재 가설에 대해 새 점의 inlier 여부만 판정하고 inlier 합계로 모델을 다시 푼다.
+// 새 점에서 뽑은 가설은 고정 크기 표본에서 먼저 평가하고, 표본에서 현재 가설보다
+// 나을 때만 전체를 다시 세어 교체한다 (드문 O(n)).
+class IncrementalRansac
+{
+public:
+    explicit IncrementalRansac(const RansacParams &params = RansacParams(),
+                               std::size_t sampleSize = 4096);
+
+    // 가설이 바뀌어 inlier 목록을 처음부터 다시 만들었으면 true
+    bool update(const PointView &points, Stats *stats = nullptr);
+    void reset();
+
+    // model 은 inlier 재추정 결과, inliers 는 현재 가설의 inlier 인덱스
+    const RansacResult &result() const { return current; }
+
+private:
+    std::size_t sampleScore(const LineModel &line) const;
+    void recount(const PointView &points, const LineModel &line, Stats *stats);
+
+    RansacParams params;
+    std::size_t sampleSize;
+    ReservoirSampler sampler;
+    std::mt19937_64 gen;
+    bool hasHypothesis = false;
+    LineModel hypothesis;
+    LineMoments inlierMoments;
+    std::vector<std::size_t> addedInliers;  // update 에서 새 점 중 inlier (버퍼 재사용)
+    RansacResult current;
+    std::size_t processed = 0;
+};
+
+// 온라인 k-means (MacQueen): 새 점을 가장 가까운 centroid 에 붙이고 그 centroid 를
+// 이동 평균으로 옮긴다. 이미 붙인 점의 라벨은 다시 계산하지 않는다.
+// centroid 가 없으면 점이 k 개 이상 모였을 때 kmeans() 한 번으로 시작한다.
+class IncrementalKMeans
+{
+public:
+    explicit IncrementalKMeans(const KMeansParams &params = KMeansParams());
+
+    void update(const PointView &points, Stats *stats = nullptr);
+    void reset();
+
+    // labels 는 전체 점, wss 는 각 점을 붙일 때의 거리로 누적한 근사값
+    const KMeansResult &result() const { return current; }
+
+private:
+    KMeansParams params;
+    KMeansResult current;
+    std::vector<std::size_t> counts;
+    std::size_t processed = 0;
+};
+
+} // namespace vision
+
+#endif // VISION_INCREMENTAL_H
@@ -0,0 +1,260 @@
+#include "inlier_kernel.h"
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VISION_INLIER_X86 1
+#include <immintrin.h>
+#endif
+
+// 커널끼리 판정이 1ulp 라도 달라지지 않도록 이 파일은 -ffp-contract=off 로
+// 빌드한다 (CMakeLists.txt). AVX-512 를 켜면 곱셈과 뺄셈이 FMA 로 합쳐질 수 있다.
+
+namespace vision {
+
+namespace {
+
+std::size_t scalarKernel(const double *x, const double *y, std::size_t count, double a, double b,
+                         double limit)
+{
+    std::size_t inliers = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        inliers += std::abs(a * x[i] - y[i] + b) < limit ? 1 : 0;
+    }
+    return inliers;
+}
+
+// 점수 커널의 합을 나눠 모으는 레인 수 (AVX2 4 x 4, AVX-512 8 x 2)
+const std::size_t scoreLanes = 16;
+
+// 레인 합을 정해진 순서로 합치고 남은 점은 차례로 더한다. 모든 수준이 같이 쓴다
+InlierScore finishScore(const double *lanes, std::size_t inliers, const double *x, const double *y,
+                        std::size_t count, double a, double b, double limit)
+{
+    InlierScore score;
+    for (std::size_t k = 0; k < scoreLanes; k++) {
+        score.squaredSum += lanes[k];
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        const double r = a * x[i] - y[i] + b;
+        if (std::abs(r) < limit) {
+            inliers++;
+            score.squaredSum += r * r;
+        }
+    }
+    score.count = inliers;
+    return score;
+}
+
+InlierScore scalarScoreKernel(const double *x, const double *y, std::size_t count, double a,
+                              double b, double limit)
+{
+    double lanes[scoreLanes] = {};
+    std::size_t inliers = 0;
+    std::size_t i = 0;
+    for (; i + scoreLanes <= count; i += scoreLanes) {
+        for (std::size_t k = 0; k < scoreLanes; k++) {
+            const double r = a * x[i + k] - y[i + k] + b;
+            const bool inlier = std::abs(r) < limit;
+            inliers += inlier ? 1 : 0;
+            lanes[k] += inlier ? r * r : 0.0;
+        }
+    }
+    return finishScore(lanes, inliers, x + i, y + i, count - i, a, b, limit);
+}
+
+#ifdef VISION_INLIER_X86
+
+__attribute__((target("avx2")))
+std::size_t avx2Kernel(const double *x, const double *y, std::size_t count, double a, double b,
+                       double limit)
+{
+    const __m256d va = _mm256_set1_pd(a);
+    const __m256d vb = _mm256_set1_pd(b);
+    const __m256d vlimit = _mm256_set1_pd(limit);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    // 비교 결과(-1)를 빼서 레인별로 센다. 두 벌로 나눠 의존성을 줄인다
+    __m256i counts0 = _mm256_setzero_si256();
+    __m256i counts1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256d r0 = _mm256_sub_pd(_mm256_mul_pd(va, _mm256_loadu_pd(x + i)), _mm256_loadu_pd(y + i));
+        __m256d r1 = _mm256_sub_pd(_mm256_mul_pd(va, _mm256_loadu_pd(x + i + 4)), _mm256_loadu_pd(y + i + 4));
+        r0 = _mm256_andnot_pd(sign, _mm256_add_pd(r0, vb));
+        r1 = _mm256_andnot_pd(sign, _mm256_add_pd(r1, vb));
+        counts0 = _mm256_sub_epi64(counts0, _mm256_castpd_si256(_mm256_cmp_pd(r0, vlimit, _CMP_LT_OQ)));
+        counts1 = _mm256_sub_epi64(counts1, _mm256_castpd_si256(_mm256_cmp_pd(r1, vlimit, _CMP_LT_OQ)));
+    }
+
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), _mm256_add_epi64(counts0, counts1));
+    const std::size_t inliers = static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return inliers + scalarKernel(x + i, y + i, count - i, a, b, limit);
+}
+
+// _mm512_reduce_add_epi64 는 GCC 12 에서 -Wmaybe-uninitialized 경고를 내므로
+// AVX2 경로처럼 저장한 뒤 레인을 더한다
+__attribute__((target("avx512f")))
+std::size_t sumLanes(__m512i counts)
+{
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, counts);
+    std::uint64_t total = 0;
+    for (int k = 0; k < 8; k++) {
+        total += lanes[k];
+    }
+    return static_cast<std::size_t>(total);
+}
+
+__attribute__((target("avx512f")))
+std::size_t avx512Kernel(const double *x, const double *y, std::size_t count, double a, double b,
+                         double limit)
+{
+    const __m512d va = _mm512_set1_pd(a);
+    const __m512d vb = _mm512_set1_pd(b);
+    const __m512d vlimit = _mm512_set1_pd(limit);
+    const __m512i one = _mm512_set1_epi64(1);
+
+    __m512i counts0 = _mm512_setzero_si512();
+    __m512i counts1 = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512d r0 = _mm512_sub_pd(_mm512_mul_pd(va, _mm512_loadu_pd(x + i)), _mm512_loadu_pd(y + i));
+        __m512d r1 = _mm512_sub_pd(_mm512_mul_pd(va, _mm512_loadu_pd(x + i + 8)), _mm512_loadu_pd(y + i + 8));
+        r0 = _mm512_abs_pd(_mm512_add_pd(r0, vb));
+        r1 = _mm512_abs_pd(_mm512_add_pd(r1, vb));
+        counts0 = _mm512_mask_add_epi64(counts0, _mm512_cmp_pd_mask(r0, vlimit, _CMP_LT_OQ), counts0, one);
+        counts1 = _mm512_mask_add_epi64(counts1, _mm512_cmp_pd_mask(r1, vlimit, _CMP_LT_OQ), counts1, one);
+    }
+
+    const std::size_t inliers = sumLanes(_mm512_add_epi64(counts0, counts1));
+    return inliers + scalarKernel(x + i, y + i, count - i, a, b, limit);
+}
+
+__attribute__((target("avx2")))
+InlierScore avx2ScoreKernel(const double *x, const double *y, std::size_t count, double a,
+                            double b, double limit)
+{
+    const __m256d va = _mm256_set1_pd(a);
+    const __m256d vb = _mm256_set1_pd(b);
+    const __m256d vlimit = _mm256_set1_pd(limit);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    // sums[k] 는 레인 4k .. 4k+3. outlier 는 마스크로 0 을 더한다
+    __m256i counts = _mm256_setzero_si256();
+    __m256d sums[4] = {_mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(),
+                       _mm256_setzero_pd()};
+    std::size_t i = 0;
+    for (; i + scoreLanes <= count; i += scoreLanes) {
+        for (int k = 0; k < 4; k++) {
+            __m256d r = _mm256_sub_pd(_mm256_mul_pd(va, _mm256_loadu_pd(x + i + 4 * k)),
+                                      _mm256_loadu_pd(y + i + 4 * k));
+            r = _mm256_add_pd(r, vb);
+            const __m256d inlier = _mm256_cmp_pd(_mm256_andnot_pd(sign, r), vlimit, _CMP_LT_OQ);
+            counts = _mm256_sub_epi64(counts, _mm256_castpd_si256(inlier));
+            sums[k] = _mm256_add_pd(sums[k], _mm256_and_pd(inlier, _mm256_mul_pd(r, r)));
+        }
+    }
+
+    alignas(32) double lanes[scoreLanes];
+    for (int k = 0; k < 4; k++) {
+        _mm256_store_pd(lanes + 4 * k, sums[k]);
+    }
+    alignas(32) std::uint64_t countLanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(countLanes), counts);
+    const std::size_t inliers =
+        static_cast<std::size_t>(countLanes[0] + countLanes[1] + countLanes[2] + countLanes[3]);
+    return finishScore(lanes, inliers, x + i, y + i, count - i, a, b, limit);
+}
+
+__attribute__((target("avx512f")))
+InlierScore avx512ScoreKernel(const double *x, const double *y, std::size_t count, double a,
+                              double b, double limit)
+{
+    const __m512d va = _mm512_set1_pd(a);
+    const __m512d vb = _mm512_set1_pd(b);
+    const __m512d vlimit = _mm512_set1_pd(limit);
+    const __m512i one = _mm512_set1_epi64(1);
+
+    // sums0 은 레인 0 .. 7, sums1 은 8 .. 15. outlier 레인은 그대로 둔다
+    __m512i counts = _mm512_setzero_si512();
+    __m512d sums0 = _mm512_setzero_pd();
+    __m512d sums1 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + scoreLanes <= count; i += scoreLanes) {
+        __m512d r0 = _mm512_sub_pd(_mm512_mul_pd(va, _mm512_loadu_pd(x + i)), _mm512_loadu_pd(y + i));
+        __m512d r1 = _mm512_sub_pd(_mm512_mul_pd(va, _mm512_loadu_pd(x + i + 8)), _mm512_loadu_pd(y + i + 8));
+        r0 = _mm512_add_pd(r0, vb);
+        r1 = _mm512_add_pd(r1, vb);
+        const __mmask8 inlier0 = _mm512_cmp_pd_mask(_mm512_abs_pd(r0), vlimit, _CMP_LT_OQ);
+        const __mmask8 inlier1 = _mm512_cmp_pd_mask(_mm512_abs_pd(r1), vlimit, _CMP_LT_OQ);
+        counts = _mm512_mask_add_epi64(counts, inlier0, counts, one);
+        counts = _mm512_mask_add_epi64(counts, inlier1, counts, one);
+        sums0 = _mm512_mask_add_pd(sums0, inlier0, sums0, _mm512_mul_pd(r0, r0));
+        sums1 = _mm512_mask_add_pd(sums1, inlier1, sums1, _mm512_mul_pd(r1, r1));
+    }
+
+    alignas(64) double lanes[scoreLanes];
+    _mm512_store_pd(lanes, sums0);
+    _mm512_store_pd(lanes + 8, sums1);
+    const std::size_t inliers = sumLanes(counts);
+    return finishScore(lanes, inliers, x + i, y + i, count - i, a, b, limit);
+}
+
+#endif
+
+} // namespace
+
+InlierCountKernel inlierCountKernel(SimdLevel level)
+{
+#ifdef VISION_INLIER_X86
+    if (level >= SimdLevel::AVX512) return avx512Kernel;
+    if (level >= SimdLevel::AVX2) return avx2Kernel;
+#else
+    (void)level;
+#endif
+    return scalarKernel;
+}
+
+InlierScoreKernel inlierScoreKernel(SimdLevel level)
+{
+#ifdef VISION_INLIER_X86
+    if (level >= SimdLevel::AVX512) return avx512ScoreKernel;
+    if (level >= SimdLevel::AVX2) return avx2ScoreKernel;
+#else
+    (void)level;
+#endif
+    return scalarScoreKernel;
+}
+
+std::size_t countInliers(const PointView &points, const LineModel &model, double threshold)
+{
+    static const InlierCountKernel kernel = inlierCountKernel();
+    return kernel(points.x, points.y, points.size, model.a, model.b, inlierLimit(model, threshold));
+}
+
+InlierScore scoreInliers(const PointView &points, const LineModel &model, double threshold)
+{
+    static const InlierScoreKernel kernel = inlierScoreKernel();
+    InlierScore score = kernel(points.x, points.y, points.size, model.a, model.b,
+                               inlierLimit(model, threshold));
+    score.squaredSum /= model.a * model.a + 1;
+    return score;
+}
+
+void collectInliers(const PointView &points, const LineModel &model, double threshold,
+                    std::vector<std::size_t> &out)
+{
+    const double a = model.a, b = model.b;
+    const double limit = inlierLimit(model, threshold);
+    out.clear();
+    for (std::size_t i = 0; i < points.size; i++) {
+        if (std::abs(a * points.x[i] - points.y[i] + b) < limit) {
+            out.push_back(i);
+        }
+    }
+}
+
+} // namespace vision
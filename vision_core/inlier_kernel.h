@@ -0,0 +1,51 @@
+#ifndef VISION_INLIER_KERNEL_H
+#define VISION_INLIER_KERNEL_H
+
+#include "line_fit.h"
+#include "point_set.h"
+#include "simd.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace vision {
+
+// |a x - y + b| < limit 인 점 수. limit = threshold * sqrt(a^2 + 1) 은 가설마다
+// 한 번 계산해서 넘긴다. 모든 수준이 같은 연산 순서라 결과가 같다.
+using InlierCountKernel = std::size_t (*)(const double *x, const double *y, std::size_t count,
+                                          double a, double b, double limit);
+
+// inlier 수와 inlier 의 잔차 제곱합 (MSAC / MLESAC 점수용)
+struct InlierScore {
+    std::size_t count = 0;
+    double squaredSum = 0;  // 커널은 (a x - y + b)^2 의 합, scoreInliers 는 거리^2 의 합
+};
+
+// 같은 판정으로 inlier 를 세면서 잔차 제곱합도 한 번에 모은다. 합은 모든 수준이
+// 16 개 레인에 (i % 16) 나눠 더한 뒤 같은 순서로 합치므로 비트까지 같다.
+using InlierScoreKernel = InlierScore (*)(const double *x, const double *y, std::size_t count,
+                                          double a, double b, double limit);
+
+// |a x - y + b| / sqrt(a^2 + 1) < threshold 에서 나눗셈과 sqrt 를 가설마다
+// 한 번으로 옮긴 판정 한계
+inline double inlierLimit(const LineModel &model, double threshold)
+{
+    return threshold * std::sqrt(model.a * model.a + 1);
+}
+
+// level 은 보통 simdLevel(). CPU 가 지원하지 않는 수준을 주면 안 된다.
+InlierCountKernel inlierCountKernel(SimdLevel level = simdLevel());
+InlierScoreKernel inlierScoreKernel(SimdLevel level = simdLevel());
+
+// model 까지의 거리가 threshold 보다 작은 점 수. 인덱스를 만들지 않고 세기만 한다
+std::size_t countInliers(const PointView &points, const LineModel &model, double threshold);
+// countInliers 와 같은 판정으로 세면서 inlier 까지의 거리 제곱합도 구한다
+InlierScore scoreInliers(const PointView &points, const LineModel &model, double threshold);
+// 같은 판정으로 inlier 인덱스를 out 에 채운다 (최종 모델에서 한 번만)
+void collectInliers(const PointView &points, const LineModel &model, double threshold,
+                    std::vector<std::size_t> &out);
+
+} // namespace vision
+
+#endif // VISION_INLIER_KERNEL_H
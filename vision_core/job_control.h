@@ -0,0 +1,50 @@
+#ifndef VISION_JOB_CONTROL_H
+#define VISION_JOB_CONTROL_H
+
+#include <atomic>
+#include <functional>
+#include <utility>
+
+namespace vision {
+
+// 백그라운드 작업의 취소와 진행률 보고.
+// 알고리즘은 nullptr 이면 아무것도 확인하지 않는다.
+class JobControl
+{
+public:
+    using ProgressCallback = std::function<void(double)>;
+
+    JobControl() = default;
+    explicit JobControl(ProgressCallback callback) : progress(std::move(callback)) {}
+
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    // 여러 단계를 한 작업으로 묶을 때, 이후 보고되는 0~1 을 [begin, end] 로 변환
+    void setProgressRange(double begin, double end)
+    {
+        rangeBegin = begin;
+        rangeEnd = end;
+    }
+
+    // fraction: 0.0 ~ 1.0. 콜백은 작업 스레드에서 호출된다.
+    void reportProgress(double fraction) const
+    {
+        if (progress) progress(rangeBegin + (rangeEnd - rangeBegin) * fraction);
+    }
+
+private:
+    std::atomic<bool> cancelled{false};
+    ProgressCallback progress;
+    double rangeBegin = 0.0;
+    double rangeEnd = 1.0;
+};
+
+inline bool isCancelled(const JobControl *control)
+{
+    return control && control->isCancelled();
+}
+
+} // namespace vision
+
+#endif // VISION_JOB_CONTROL_H
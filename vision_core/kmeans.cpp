@@ -0,0 +1,180 @@
+#include "kmeans.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace vision {
+
+namespace {
+
+inline double squaredDistance(double x, double y, const Centroid &c)
+{
+    const double dx = x - c.x;
+    const double dy = y - c.y;
+    return dx * dx + dy * dy;
+}
+
+} // namespace
+
+std::vector<Centroid> initializeCentroids(const PointView &points, int k, std::mt19937_64 &gen)
+{
+    std::vector<Centroid> centroids;
+    if (points.size == 0 || k <= 0) {
+        return centroids;
+    }
+    centroids.reserve(k);
+
+    // 첫 번째 centroid 무작위 선택
+    std::uniform_int_distribution<std::size_t> dis(0, points.size - 1);
+    const std::size_t firstIdx = dis(gen);
+    centroids.push_back(Centroid{points.x[firstIdx], points.y[firstIdx]});
+
+    // 가장 가까운 centroid까지의 거리. 새 centroid가 생길 때마다 갱신만 한다.
+    std::vector<double> distances(points.size, std::numeric_limits<double>::max());
+
+    for (int i = 1; i < k; i++) {
+        const Centroid &last = centroids.back();
+        double totalDistance = 0;
+        for (std::size_t j = 0; j < points.size; j++) {
+            distances[j] = std::min(distances[j], squaredDistance(points.x[j], points.y[j], last));
+            totalDistance += distances[j];
+        }
+
+        // 거리 제곱에 비례하는 확률로 다음 centroid 선택
+        std::uniform_real_distribution<> realDis(0, totalDistance);
+        const double rand = realDis(gen);
+        double sum = 0;
+        std::size_t centroidIdx = 0;
+        for (std::size_t j = 0; j < points.size; j++) {
+            sum += distances[j];
+            if (sum > rand) {
+                centroidIdx = j;
+                break;
+            }
+        }
+
+        centroids.push_back(Centroid{points.x[centroidIdx], points.y[centroidIdx]});
+    }
+
+    return centroids;
+}
+
+std::size_t assignClusters(const PointView &points, const std::vector<Centroid> &centroids,
+                           int *labels)
+{
+    const int k = static_cast<int>(centroids.size());
+    std::size_t reassigned = 0;
+    for (std::size_t i = 0; i < points.size; i++) {
+        double minDist = std::numeric_limits<double>::max();
+        int closestCluster = 0;
+
+        // sqrt는 단조 증가이므로 거리 제곱으로 비교
+        for (int c = 0; c < k; c++) {
+            const double dist = squaredDistance(points.x[i], points.y[i], centroids[c]);
+            if (dist < minDist) {
+                minDist = dist;
+                closestCluster = c;
+            }
+        }
+        reassigned += labels[i] != closestCluster;
+        labels[i] = closestCluster;
+    }
+    return reassigned;
+}
+
+std::vector<Centroid> updateCentroids(const PointView &points, const int *labels, int k)
+{
+    std::vector<Centroid> newCentroids(k);
+    std::vector<std::size_t> counts(k, 0);
+
+    for (std::size_t i = 0; i < points.size; i++) {
+        const int cluster = labels[i];
+        if (cluster >= 0 && cluster < k) {
+            newCentroids[cluster].x += points.x[i];
+            newCentroids[cluster].y += points.y[i];
+            counts[cluster]++;
+        }
+    }
+
+    for (int c = 0; c < k; c++) {
+        if (counts[c] > 0) {
+            newCentroids[c].x /= counts[c];
+            newCentroids[c].y /= counts[c];
+        }
+    }
+
+    return newCentroids;
+}
+
+bool hasConverged(const std::vector<Centroid> &oldCentroids,
+                  const std::vector<Centroid> &newCentroids,
+                  double tolerance)
+{
+    if (oldCentroids.size() != newCentroids.size()) return false;
+
+    for (std::size_t i = 0; i < oldCentroids.size(); i++) {
+        if (std::abs(oldCentroids[i].x - newCentroids[i].x) > tolerance ||
+            std::abs(oldCentroids[i].y - newCentroids[i].y) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double computeWSS(const PointView &points, const std::vector<Centroid> &centroids)
+{
+    double wss = 0;
+    for (std::size_t i = 0; i < points.size; i++) {
+        double minDist = std::numeric_limits<double>::max();
+        for (const Centroid &centroid : centroids) {
+            minDist = std::min(minDist, squaredDistance(points.x[i], points.y[i], centroid));
+        }
+        wss += minDist;
+    }
+    return wss;
+}
+
+KMeansResult kmeans(const PointView &points, const KMeansParams &params, JobControl *control,
+                    Stats *stats)
+{
+    KMeansResult result;
+    if (points.size == 0 || params.k <= 0) {
+        return result;
+    }
+
+    std::mt19937_64 gen(params.seed != 0 ? params.seed : std::random_device()());
+
+    {
+        VISION_STAT_TIMER(stats, Stage::KMeansInit);
+        result.centroids = initializeCentroids(points, params.k, gen);
+    }
+    result.labels.assign(points.size, -1);
+
+    while (!result.converged && result.iterations < params.maxIterations) {
+        if (isCancelled(control)) break;
+        if (control) {
+            control->reportProgress(static_cast<double>(result.iterations) / params.maxIterations);
+        }
+        {
+            VISION_STAT_TIMER(stats, Stage::KMeansAssign);
+            const std::size_t reassigned = assignClusters(points, result.centroids, result.labels.data());
+            if (VISION_ENABLE_STATS && stats) stats->pointsReassigned.push_back(reassigned);
+        }
+
+        std::vector<Centroid> newCentroids;
+        {
+            VISION_STAT_TIMER(stats, Stage::KMeansUpdate);
+            newCentroids = updateCentroids(points, result.labels.data(), params.k);
+        }
+        VISION_STAT_ADD(stats, kmeansIterations, 1);
+        result.converged = hasConverged(result.centroids, newCentroids, params.tolerance);
+        result.centroids = std::move(newCentroids);
+        result.iterations++;
+    }
+
+    result.wss = computeWSS(points, result.centroids);
+    return result;
+}
+
+} // namespace vision
@@ -0,0 +1,57 @@
+#ifndef VISION_KMEANS_H
+#define VISION_KMEANS_H
+
+#include "job_control.h"
+#include "point_set.h"
+#include "stats.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace vision {
+
+struct Centroid {
+    double x = 0;
+    double y = 0;
+};
+
+struct KMeansParams {
+    int k = 3;
+    int maxIterations = 100;
+    double tolerance = 0.0001;  // centroid 이동량이 이보다 작으면 수렴
+    std::uint64_t seed = 0;     // 0이면 std::random_device 사용
+};
+
+struct KMeansResult {
+    std::vector<Centroid> centroids;
+    std::vector<int> labels;  // 점별 클러스터 번호
+    int iterations = 0;
+    bool converged = false;
+    double wss = 0;           // Within-cluster Sum of Squares
+};
+
+// k-means++ 초기화
+std::vector<Centroid> initializeCentroids(const PointView &points, int k, std::mt19937_64 &gen);
+
+// 각 점을 가장 가까운 centroid에 할당 (labels는 points.size 크기).
+// 라벨이 바뀐 점 수를 반환한다.
+std::size_t assignClusters(const PointView &points, const std::vector<Centroid> &centroids,
+                           int *labels);
+
+// 할당 결과로 centroid 재계산 (빈 클러스터는 원점)
+std::vector<Centroid> updateCentroids(const PointView &points, const int *labels, int k);
+
+bool hasConverged(const std::vector<Centroid> &oldCentroids,
+                  const std::vector<Centroid> &newCentroids,
+                  double tolerance);
+
+double computeWSS(const PointView &points, const std::vector<Centroid> &centroids);
+
+// 수렴하거나 maxIterations 까지 Lloyd 반복. 취소되면 마지막 반복 결과를 반환한다.
+KMeansResult kmeans(const PointView &points, const KMeansParams &params = KMeansParams(),
+                    JobControl *control = nullptr, Stats *stats = nullptr);
+
+} // namespace vision
+
+#endif // VISION_KMEANS_H
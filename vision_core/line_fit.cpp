@@ -0,0 +1,93 @@
+#include "line_fit.h"
+
+namespace vision {
+
+void LineMoments::merge(const LineMoments &other)
+{
+    if (other.n == 0) {
+        return;
+    }
+    if (n == 0) {
+        *this = other;
+        return;
+    }
+
+    // Chan 등의 병렬 결합 공식
+    const double n1 = static_cast<double>(n);
+    const double n2 = static_cast<double>(other.n);
+    const double total = n1 + n2;
+    const double dx = other.meanX - meanX;
+    const double dy = other.meanY - meanY;
+    const double weight = n1 * n2 / total;
+
+    meanX += dx * (n2 / total);
+    meanY += dy * (n2 / total);
+    m2X += other.m2X + dx * dx * weight;
+    m2Y += other.m2Y + dy * dy * weight;
+    cXY += other.cXY + dx * dy * weight;
+    n += other.n;
+}
+
+LineModel LineMoments::solve() const
+{
+    LineModel model;
+    if (n == 0) {
+        return model;
+    }
+
+    // n * m2X 는 원시 합으로 쓴 n * sumX2 - sumX^2 와 같은 값
+    const double denom = static_cast<double>(n) * m2X;
+
+    // x가 모두 같으면 (수직선) 평균 y의 수평선으로 대체
+    if (std::abs(denom) < 0.0001) {
+        model.a = 0;
+        model.b = meanY;
+    } else {
+        model.a = cXY / m2X;
+        model.b = meanY - model.a * meanX;
+    }
+    return model;
+}
+
+double LineMoments::squaredError(const LineModel &model) const
+{
+    // y - a x - b = (y - meanY) - a (x - meanX) + (meanY - a meanX - b) 로 나눠 전개한다.
+    // 중심 모멘트끼리의 뺄셈이라 큰 좌표에서도 상쇄가 작다. 반올림으로 아주 작은
+    // 음수가 될 수 있어 0 으로 자른다.
+    const double a = model.a;
+    const double offset = meanY - a * meanX - model.b;
+    const double error = m2Y - 2 * a * cXY + a * a * m2X + static_cast<double>(n) * offset * offset;
+    return error > 0 ? error : 0;
+}
+
+LineModel fitLineLeastSquares(const PointView &points)
+{
+    LineMoments moments;
+    for (std::size_t i = 0; i < points.size; i++) {
+        moments.add(points.x[i], points.y[i]);
+    }
+    return moments.solve();
+}
+
+LineModel fitLineLeastSquares(const PointView &points,
+                              const std::size_t *indices, std::size_t count)
+{
+    LineMoments moments;
+    for (std::size_t i = 0; i < count; i++) {
+        const std::size_t idx = indices[i];
+        moments.add(points.x[idx], points.y[idx]);
+    }
+    return moments.solve();
+}
+
+double sumSquaredError(const PointView &points, const LineModel &model)
+{
+    double totalError = 0;
+    for (std::size_t i = 0; i < points.size; i++) {
+        const double error = points.y[i] - (model.a * points.x[i] + model.b);
+        totalError += error * error;
+    }
+    return totalError;
+}
+
+} // namespace vision
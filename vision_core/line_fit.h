@@ -0,0 +1,64 @@
+#ifndef VISION_LINE_FIT_H
+#define VISION_LINE_FIT_H
+
+#include "point_set.h"
+
+#include <cmath>
+#include <cstddef>
+
+namespace vision {
+
+// 직선 모델 y = a * x + b
+struct LineModel {
+    double a = 0;  // 기울기
+    double b = 0;  // y절편
+};
+
+// 최소제곱법에 필요한 평균과 중심 모멘트 (Welford). 청크 단위로 누적한 뒤 merge 할 수 있다.
+// 원시 합(sum x^2 등)으로 풀면 좌표가 원점에서 멀 때 자릿수가 상쇄되어 잃는다.
+struct LineMoments {
+    std::size_t n = 0;
+    double meanX = 0;
+    double meanY = 0;
+    double m2X = 0;  // sum (x - meanX)^2
+    double m2Y = 0;  // sum (y - meanY)^2
+    double cXY = 0;  // sum (x - meanX)(y - meanY)
+
+    void add(double x, double y)
+    {
+        n++;
+        const double rate = 1.0 / static_cast<double>(n);
+        const double dx = x - meanX;
+        const double dy = y - meanY;
+        meanX += dx * rate;
+        meanY += dy * rate;
+        m2X += dx * (x - meanX);
+        m2Y += dy * (y - meanY);
+        cXY += dx * (y - meanY);
+    }
+
+    void merge(const LineMoments &other);
+    LineModel solve() const;
+
+    // 점을 다시 보지 않고 구한 sumSquaredError (스트리밍용)
+    double squaredError(const LineModel &model) const;
+};
+
+// 최소제곱법 직선 추정
+LineModel fitLineLeastSquares(const PointView &points);
+// indices에 해당하는 점들만 사용 (RANSAC inlier 재추정용)
+LineModel fitLineLeastSquares(const PointView &points,
+                              const std::size_t *indices, std::size_t count);
+
+// 각 점의 수직(y 방향) 오차 제곱합
+double sumSquaredError(const PointView &points, const LineModel &model);
+
+// 점에서 직선까지의 수직 거리
+inline double pointLineDistance(double x, double y, const LineModel &model)
+{
+    return std::abs(model.a * x - y + model.b) / std::sqrt(model.a * model.a + 1);
+}
+
+} // namespace vision
+
+#endif // VISION_LINE_FIT_H
@@ -0,0 +1,69 @@
+#include "mapped_file.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vision {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string &path, std::string *error)
+{
+    close();
+
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (error) *error = "Cannot open file for reading: " + path;
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void *p = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            // 처음부터 끝까지 한 번 훑는 용도
+            ::madvise(p, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+            mapped = p;
+            length = static_cast<std::size_t>(info.st_size);
+            ::close(fd);
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        if (error) *error = "Cannot open file for reading: " + path;
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    length = buffer.size();
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifndef _WIN32
+    if (mapped) {
+        ::munmap(mapped, length);
+    }
+#endif
+    mapped = nullptr;
+    length = 0;
+    buffer.clear();
+    buffer.shrink_to_fit();
+}
+
+} // namespace vision
@@ -0,0 +1,36 @@
+#ifndef VISION_MAPPED_FILE_H
+#define VISION_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+// 읽기 전용 파일 매핑. mmap 이 안 되는 경우(빈 파일, 파이프, Windows)는
+// 내부 버퍼로 읽어서 같은 인터페이스를 제공한다.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::string &path, std::string *error = nullptr);
+    void close();
+
+    const char *data() const { return mapped ? static_cast<const char *>(mapped) : buffer.data(); }
+    std::size_t size() const { return length; }
+    bool isMapped() const { return mapped != nullptr; }
+
+private:
+    void *mapped = nullptr;
+    std::size_t length = 0;
+    std::vector<char> buffer;
+};
+
+} // namespace vision
+
+#endif // VISION_MAPPED_FILE_H
@@ -0,0 +1,107 @@
+#include "number_parse.h"
+
+#include <charconv>
+#include <cstdint>
+
+namespace vision {
+
+namespace {
+
+// double 로 정확히 표현되는 10의 거듭제곱
+const double exactPowersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+const std::uint64_t maxExactMantissa = std::uint64_t(1) << 53;
+
+bool parseSlow(const char *begin, const char *end, double &value)
+{
+    const std::from_chars_result r = std::from_chars(begin, end, value);
+    return r.ec == std::errc() && r.ptr == end;
+}
+
+inline bool isDigit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+} // namespace
+
+bool parseDouble(const char *begin, const char *end, double &value)
+{
+    const char *p = begin;
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        p++;
+    }
+
+    // 가수: 최대 19자리까지 정수로 모은다
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    const char *digitsStart = p;
+
+    while (p < end && isDigit(*p)) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa != 0) digits++;
+        } else {
+            return parseSlow(begin, end, value);
+        }
+        p++;
+    }
+    bool anyDigits = p != digitsStart;
+
+    if (p < end && *p == '.') {
+        p++;
+        const char *fractionStart = p;
+        while (p < end && isDigit(*p)) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa != 0) digits++;
+                exponent--;
+            } else {
+                return parseSlow(begin, end, value);
+            }
+            p++;
+        }
+        anyDigits = anyDigits || p != fractionStart;
+    }
+    if (!anyDigits) {
+        // "inf", "nan", ".", "" 등
+        return parseSlow(begin, end, value);
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            negativeExponent = *p == '-';
+            p++;
+        }
+        if (p == end || !isDigit(*p)) return false;
+
+        int e = 0;
+        while (p < end && isDigit(*p)) {
+            if (e < 10000) e = e * 10 + (*p - '0');
+            p++;
+        }
+        exponent += negativeExponent ? -e : e;
+    }
+    if (p != end) {
+        return false;
+    }
+
+    // 가수와 10^|exponent| 가 모두 정확하면 한 번의 곱/나눗셈만 반올림된다
+    if (mantissa <= maxExactMantissa && exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / exactPowersOf10[-exponent] : result * exactPowersOf10[exponent];
+        value = negative ? -result : result;
+        return true;
+    }
+    return parseSlow(begin, end, value);
+}
+
+} // namespace vision
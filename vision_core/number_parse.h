@@ -0,0 +1,14 @@
+#ifndef VISION_NUMBER_PARSE_H
+#define VISION_NUMBER_PARSE_H
+
+namespace vision {
+
+// [begin, end) 전체가 10진 실수일 때만 true.
+// 유효 숫자 15~16 자리 이하의 흔한 경우는 정확한 빠른 경로(Clinger)로 처리하고,
+// 나머지(긴 가수, 큰 지수, inf/nan 등)는 std::from_chars 로 넘긴다.
+// 결과는 항상 올바르게 반올림된 값이다.
+bool parseDouble(const char *begin, const char *end, double &value);
+
+} // namespace vision
+
+#endif // VISION_NUMBER_PARSE_H
@@ -0,0 +1,64 @@
+#ifndef VISION_POINT_SET_H
+#define VISION_POINT_SET_H
+
+#include <cstddef>
+#include <vector>
+
+namespace vision {
+
+// 알고리즘에 넘기는 읽기 전용 뷰 (x, y 각각 연속 배열)
+struct PointView {
+    const double *x = nullptr;
+    const double *y = nullptr;
+    std::size_t size = 0;
+};
+
+// x, y를 별도 배열(SoA)로 보관하는 점 집합
+struct PointSet {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<int> labels;  // 정답 라벨 열을 읽었을 때만 x 와 같은 길이, 아니면 비어 있음
+
+    std::size_t size() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+    bool hasLabels() const { return !labels.empty(); }
+
+    void reserve(std::size_t n)
+    {
+        x.reserve(n);
+        y.reserve(n);
+    }
+
+    void clear()
+    {
+        x.clear();
+        y.clear();
+        labels.clear();
+    }
+
+    void append(double px, double py)
+    {
+        x.push_back(px);
+        y.push_back(py);
+    }
+
+    void append(double px, double py, int label)
+    {
+        append(px, py);
+        labels.push_back(label);
+    }
+
+    // other 의 점을 뒤에 이어 붙인다 (라벨은 둘 다 있을 때만 의미가 있다)
+    void append(const PointSet &other)
+    {
+        x.insert(x.end(), other.x.begin(), other.x.end());
+        y.insert(y.end(), other.y.begin(), other.y.end());
+        labels.insert(labels.end(), other.labels.begin(), other.labels.end());
+    }
+
+    PointView view() const { return PointView{x.data(), y.data(), x.size()}; }
+};
+
+} // namespace vision
+
+#endif // VISION_POINT_SET_H
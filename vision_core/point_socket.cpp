@@ -0,0 +1,442 @@
+#include "point_socket.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace vision {
+
+namespace {
+
+#ifndef _WIN32
+
+// 끊긴 연결에 쓸 때 SIGPIPE 로 프로세스가 죽지 않도록
+#ifdef MSG_NOSIGNAL
+const int sendFlags = MSG_NOSIGNAL;
+#else
+const int sendFlags = 0;
+#endif
+
+// 커널 버퍼가 작으면 프레임마다 여러 번 깨어나므로 넉넉하게 (실패해도 무시)
+const int socketBufferBytes = 4 << 20;
+
+void enlargeBuffers(int fd)
+{
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &socketBufferBytes, sizeof(socketBufferBytes));
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &socketBufferBytes, sizeof(socketBufferBytes));
+#ifdef SO_NOSIGPIPE
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
+bool socketAddress(const std::string &path, sockaddr_un &address, std::string *error)
+{
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        if (error) *error = "Invalid socket path: " + path;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+// 이전 실행이 남긴 소켓 파일만 지운다. 소켓이 아닌 파일이나 아직 누가 듣고 있는
+// 소켓은 건드리지 않고 실패한다.
+bool removeStaleSocket(const std::string &path, const sockaddr_un &address, std::string *error)
+{
+    struct stat info;
+    if (::lstat(path.c_str(), &info) != 0) {
+        if (errno == ENOENT) return true;
+        if (error) *error = "Cannot listen on " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    if (!S_ISSOCK(info.st_mode)) {
+        if (error) *error = "Cannot listen on " + path + ": path exists and is not a socket";
+        return false;
+    }
+
+    // 연결이 거부되면 듣는 프로세스가 없는 것
+    const int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) {
+        if (error) *error = std::string("Cannot create socket: ") + std::strerror(errno);
+        return false;
+    }
+    const bool refused = ::connect(probe, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 &&
+                         errno == ECONNREFUSED;
+    ::close(probe);
+    if (!refused) {
+        if (error) *error = "Cannot listen on " + path + ": path exists and is in use";
+        return false;
+    }
+    ::unlink(path.c_str());
+    return true;
+}
+
+// 헤더와 열 배열을 한 번의 sendmsg 로 (부분 전송이면 남은 부분부터 이어서)
+bool sendAll(int fd, iovec *iov, int count, std::uint64_t &sent)
+{
+    while (count > 0) {
+        msghdr message = {};
+        message.msg_iov = iov;
+        message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(count);
+        const ssize_t n = ::sendmsg(fd, &message, sendFlags);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<std::uint64_t>(n);
+
+        std::size_t left = static_cast<std::size_t>(n);
+        while (count > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+    return true;
+}
+
+#endif
+
+} // namespace
+
+PointSocketReceiver::~PointSocketReceiver()
+{
+    close();
+}
+
+void PointSocketReceiver::close()
+{
+#ifndef _WIN32
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+    fd = -1;
+}
+
+bool PointSocketReceiver::readFull(void *data, std::size_t size, bool &closed)
+{
+    closed = false;
+#ifndef _WIN32
+    char *p = static_cast<char *>(data);
+    std::size_t filled = 0;
+    while (filled < size) {
+        const ssize_t n = ::recv(fd, p + filled, size - filled, MSG_WAITALL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) {
+            closed = filled == 0;
+            return false;
+        }
+        filled += static_cast<std::size_t>(n);
+        bytes += static_cast<std::uint64_t>(n);
+    }
+    return true;
+#else
+    (void)data;
+    (void)size;
+    return false;
+#endif
+}
+
+PointSocketReceiver::Status PointSocketReceiver::receive(PointSet &out, std::string *error)
+{
+    auto fail = [&](const char *reason) {
+        if (error) *error = reason;
+        close();
+        return Status::Error;
+    };
+
+    if (fd < 0) {
+        return fail("Socket is not connected");
+    }
+
+    PointFrameHeader header;
+    bool closed = false;
+    if (!readFull(&header, sizeof(header), closed)) {
+        if (closed) {
+            close();
+            return Status::Closed;
+        }
+        return fail("Truncated point frame");
+    }
+    if (std::memcmp(header.magic, "VPFR", 4) != 0 || header.count > pointFrameMaxPoints ||
+        (header.flags & ~pointFrameHasLabels) != 0) {
+        return fail("Invalid point frame");
+    }
+
+    if (header.type == PointFrameType::Reset) {
+        return header.count == 0 ? Status::Reset : fail("Invalid point frame");
+    }
+    if (header.type != PointFrameType::Points) {
+        return fail("Invalid point frame");
+    }
+
+    // 배열 끝을 늘리고 소켓에서 그 자리로 바로 읽는다
+    const std::size_t first = out.size();
+    const std::size_t count = header.count;
+    const bool frameLabels = (header.flags & pointFrameHasLabels) != 0;
+    const bool keepLabels = frameLabels && out.labels.size() == first;
+    out.x.resize(first + count);
+    out.y.resize(first + count);
+    if (keepLabels) out.labels.resize(first + count);
+
+    bool ok = readFull(out.x.data() + first, count * sizeof(double), closed) &&
+              readFull(out.y.data() + first, count * sizeof(double), closed);
+    if (ok && frameLabels) {
+        int *labels = out.labels.data() + first;
+        if (!keepLabels) {
+            discardedLabels.resize(count);
+            labels = discardedLabels.data();
+        }
+        ok = readFull(labels, count * sizeof(int), closed);
+    }
+    if (!ok) {
+        out.x.resize(first);
+        out.y.resize(first);
+        if (keepLabels) out.labels.resize(first);
+        return fail("Truncated point frame");
+    }
+
+    // 라벨 없는 프레임이 섞이면 라벨은 더 이상 점과 맞지 않는다
+    if (!frameLabels && !out.labels.empty()) {
+        out.labels.clear();
+    }
+    return Status::Points;
+}
+
+PointSocketListener::~PointSocketListener()
+{
+    close();
+}
+
+bool PointSocketListener::listen(const std::string &path, std::string *error)
+{
+    close();
+
+#ifndef _WIN32
+    sockaddr_un address;
+    if (!socketAddress(path, address, error) || !removeStaleSocket(path, address, error)) {
+        return false;
+    }
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        if (error) *error = std::string("Cannot create socket: ") + std::strerror(errno);
+        return false;
+    }
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 4) != 0) {
+        if (error) *error = "Cannot listen on " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    socketPath = path;
+    return true;
+#else
+    if (error) *error = "Unix domain sockets are not supported on this platform: " + path;
+    return false;
+#endif
+}
+
+bool PointSocketListener::accept(PointSocketReceiver &receiver, std::string *error)
+{
+    receiver.close();
+#ifndef _WIN32
+    if (fd < 0) {
+        if (error) *error = "Socket is not listening";
+        return false;
+    }
+    int client;
+    do {
+        client = ::accept(fd, nullptr, nullptr);
+    } while (client < 0 && errno == EINTR);
+    if (client < 0) {
+        if (error) *error = std::string("Cannot accept connection: ") + std::strerror(errno);
+        return false;
+    }
+    enlargeBuffers(client);
+    receiver.fd = client;
+    receiver.bytes = 0;
+    return true;
+#else
+    if (error) *error = "Unix domain sockets are not supported on this platform";
+    return false;
+#endif
+}
+
+void PointSocketListener::close()
+{
+#ifndef _WIN32
+    if (fd >= 0) {
+        ::close(fd);
+        ::unlink(socketPath.c_str());
+    }
+#endif
+    fd = -1;
+    socketPath.clear();
+}
+
+PointSocketSender::PointSocketSender(std::size_t batchPoints)
+    : batchPoints(std::min<std::size_t>(std::max<std::size_t>(batchPoints, 1), pointFrameMaxPoints))
+{
+}
+
+PointSocketSender::~PointSocketSender()
+{
+    close();
+}
+
+bool PointSocketSender::connect(const std::string &path, std::string *error)
+{
+    close();
+    failure.clear();
+    bytes = 0;
+
+#ifndef _WIN32
+    sockaddr_un address;
+    if (!socketAddress(path, address, error)) {
+        return false;
+    }
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+        if (error) *error = "Cannot connect to " + path + ": " + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        return false;
+    }
+    enlargeBuffers(fd);
+    return true;
+#else
+    if (error) *error = "Unix domain sockets are not supported on this platform: " + path;
+    return false;
+#endif
+}
+
+bool PointSocketSender::send(const PointView &points, const int *labels)
+{
+    if (fd < 0) {
+        if (failure.empty()) failure = "Socket is not connected";
+        return false;
+    }
+
+    // 라벨 유무가 바뀌면 모아 둔 점을 먼저 보낸다
+    const bool withLabels = labels != nullptr;
+    if (!pending.empty() && pendingLabels != withLabels && !flush()) {
+        return false;
+    }
+
+    std::size_t offset = 0;
+    while (offset < points.size) {
+        const std::size_t left = points.size - offset;
+        if (pending.empty() && left >= batchPoints) {
+            // 한 프레임이 꽉 차면 호출한 쪽 배열에서 바로 보낸다
+            const PointView slice{points.x + offset, points.y + offset, batchPoints};
+            if (!sendFrame(PointFrameType::Points, slice, withLabels ? labels + offset : nullptr)) {
+                return false;
+            }
+            offset += batchPoints;
+            continue;
+        }
+
+        const std::size_t take = std::min(batchPoints - pending.size(), left);
+        pending.x.insert(pending.x.end(), points.x + offset, points.x + offset + take);
+        pending.y.insert(pending.y.end(), points.y + offset, points.y + offset + take);
+        if (withLabels) {
+            pending.labels.insert(pending.labels.end(), labels + offset, labels + offset + take);
+        }
+        pendingLabels = withLabels;
+        offset += take;
+
+        if (pending.size() >= batchPoints && !flush()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PointSocketSender::sendReset()
+{
+    return flush() && sendFrame(PointFrameType::Reset, PointView(), nullptr);
+}
+
+bool PointSocketSender::flush()
+{
+    if (pending.empty()) {
+        return fd >= 0;
+    }
+    const bool ok = sendFrame(PointFrameType::Points, pending.view(),
+                              pendingLabels ? pending.labels.data() : nullptr);
+    pending.clear();
+    return ok;
+}
+
+void PointSocketSender::close()
+{
+    if (fd < 0) {
+        return;
+    }
+    flush();
+#ifndef _WIN32
+    ::close(fd);
+#endif
+    fd = -1;
+}
+
+bool PointSocketSender::sendFrame(PointFrameType type, const PointView &points, const int *labels)
+{
+#ifndef _WIN32
+    if (fd < 0) {
+        return false;
+    }
+
+    PointFrameHeader header;
+    header.type = type;
+    header.count = static_cast<std::uint32_t>(points.size);
+    header.flags = labels ? pointFrameHasLabels : 0;
+
+    iovec iov[4];
+    int count = 0;
+    iov[count++] = {&header, sizeof(header)};
+    if (points.size > 0) {
+        iov[count++] = {const_cast<double *>(points.x), points.size * sizeof(double)};
+        iov[count++] = {const_cast<double *>(points.y), points.size * sizeof(double)};
+        if (labels) {
+            iov[count++] = {const_cast<int *>(labels), points.size * sizeof(int)};
+        }
+    }
+    if (!sendAll(fd, iov, count, bytes)) {
+        failure = std::string("Send failed: ") + std::strerror(errno);
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+#else
+    (void)type;
+    (void)points;
+    (void)labels;
+    return false;
+#endif
+}
+
+} // namespace vision
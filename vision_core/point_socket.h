@@ -0,0 +1,124 @@
+#ifndef VISION_POINT_SOCKET_H
+#define VISION_POINT_SOCKET_H
+
+#include "point_set.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+// 다른 프로세스가 Unix 도메인 소켓으로 점을 밀어 넣는 프로토콜 (같은 머신, native endian).
+// 프레임 = 헤더 + x[count] (double) + y[count] (double) + labels[count] (int32, 있을 때만).
+// 열 단위(SoA)로 보내므로 받는 쪽은 PointSet 배열 끝에 바로 recv 한다 (중간 버퍼 없음).
+// 소켓은 블로킹이라 받는 쪽이 늦으면 커널 버퍼가 차서 보내는 쪽이 멈춘다 (backpressure).
+enum class PointFrameType : std::uint32_t {
+    Points = 1,
+    Reset = 2,  // 지금까지 보낸 점을 버리고 처음부터 (새 데이터셋)
+};
+
+const std::uint32_t pointFrameHasLabels = 1;
+const std::uint32_t pointFrameMaxPoints = 1 << 22;  // 이보다 큰 프레임은 프로토콜 오류
+
+struct PointFrameHeader {
+    char magic[4] = {'V', 'P', 'F', 'R'};
+    PointFrameType type = PointFrameType::Points;
+    std::uint32_t count = 0;
+    std::uint32_t flags = 0;
+};
+static_assert(sizeof(PointFrameHeader) == 16, "PointFrameHeader layout");
+
+class PointSocketListener;
+
+// 연결 하나에서 프레임을 읽는다
+class PointSocketReceiver
+{
+public:
+    enum class Status {
+        Points,  // 점을 out 뒤에 추가함
+        Reset,   // 보내는 쪽이 처음부터 다시 시작
+        Closed,  // 정상 종료 (프레임 경계에서 연결이 끊김)
+        Error,
+    };
+
+    PointSocketReceiver() = default;
+    ~PointSocketReceiver();
+
+    PointSocketReceiver(const PointSocketReceiver &) = delete;
+    PointSocketReceiver &operator=(const PointSocketReceiver &) = delete;
+
+    // 다음 프레임 하나를 기다려 처리. 라벨은 out 의 모든 점에 라벨이 있을 때만 이어 붙인다.
+    Status receive(PointSet &out, std::string *error = nullptr);
+    void close();
+
+    bool isOpen() const { return fd >= 0; }
+    std::uint64_t bytesReceived() const { return bytes; }
+
+private:
+    friend class PointSocketListener;
+
+    bool readFull(void *data, std::size_t size, bool &closed);
+
+    int fd = -1;
+    std::uint64_t bytes = 0;
+    std::vector<int> discardedLabels;
+};
+
+// 소켓 파일을 만들고 연결을 받는다. 닫을 때 소켓 파일을 지운다.
+class PointSocketListener
+{
+public:
+    PointSocketListener() = default;
+    ~PointSocketListener();
+
+    PointSocketListener(const PointSocketListener &) = delete;
+    PointSocketListener &operator=(const PointSocketListener &) = delete;
+
+    // 같은 경로에 남아 있는 소켓 파일은 지우고 다시 만든다
+    bool listen(const std::string &path, std::string *error = nullptr);
+    bool accept(PointSocketReceiver &receiver, std::string *error = nullptr);
+    void close();
+
+private:
+    int fd = -1;
+    std::string socketPath;
+};
+
+// 보내는 쪽. 작은 입력은 batchPoints 까지 모아서 한 프레임으로,
+// 큰 입력은 호출한 쪽 배열에서 복사 없이 바로 보낸다.
+class PointSocketSender
+{
+public:
+    explicit PointSocketSender(std::size_t batchPoints = 1 << 16);
+    ~PointSocketSender();
+
+    PointSocketSender(const PointSocketSender &) = delete;
+    PointSocketSender &operator=(const PointSocketSender &) = delete;
+
+    bool connect(const std::string &path, std::string *error = nullptr);
+
+    // labels 는 nullptr 이거나 points.size 개
+    bool send(const PointView &points, const int *labels = nullptr);
+    bool sendReset();
+    bool flush();
+    void close();  // 남은 점을 보내고 닫는다
+
+    const std::string &error() const { return failure; }
+    std::uint64_t bytesSent() const { return bytes; }
+
+private:
+    bool sendFrame(PointFrameType type, const PointView &points, const int *labels);
+
+    int fd = -1;
+    std::size_t batchPoints;
+    PointSet pending;
+    bool pendingLabels = false;
+    std::uint64_t bytes = 0;
+    std::string failure;
+};
+
+} // namespace vision
+
+#endif // VISION_POINT_SOCKET_H
@@ -0,0 +1,220 @@
+#include "point_source.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace vision {
+
+namespace {
+
+std::size_t fileSizeOf(const std::string &path)
+{
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : static_cast<std::size_t>(size);
+}
+
+bool hasExtension(const std::string &path, const char *extension)
+{
+    const std::size_t length = std::strlen(extension);
+    return path.size() >= length && path.compare(path.size() - length, length, extension) == 0;
+}
+
+} // namespace
+
+CsvChunkSource::CsvChunkSource(const CsvOptions &options, std::size_t bufferBytes)
+    : options(options)
+    , buffer(std::max<std::size_t>(bufferBytes, 4096))
+{
+}
+
+CsvChunkSource::~CsvChunkSource()
+{
+    close();
+}
+
+bool CsvChunkSource::open(const std::string &path, std::string *error)
+{
+    close();
+
+    stream = openByteStream(path, error, &compression);
+    if (!stream) {
+        return false;
+    }
+    this->path = path;
+    fileSize = fileSizeOf(path);
+    return rewind();
+}
+
+void CsvChunkSource::close()
+{
+    stream.reset();
+}
+
+bool CsvChunkSource::rewind()
+{
+    // 압축 스트림은 되감을 수 없으므로 다시 연다 (처음 열 때는 이미 처음 위치)
+    if (consumed > 0 || pending > 0 || eof) {
+        stream = openByteStream(path, nullptr, &compression);
+    }
+    if (!stream) {
+        failure = "Cannot rewind: " + path;
+        return false;
+    }
+    pending = 0;
+    consumed = 0;
+    points = 0;
+    lineNumber = 1;
+    headerPending = options.skipHeader;
+    eof = false;
+    failure.clear();
+    stats = CsvStats();
+    return true;
+}
+
+std::size_t CsvChunkSource::bytesRead() const
+{
+    if (compression == Compression::None || !stream) {
+        return consumed;
+    }
+    return stream->sourceBytesRead();
+}
+
+bool CsvChunkSource::next(PointSet &chunk)
+{
+    chunk.clear();
+    if (!stream || !failure.empty()) {
+        return false;
+    }
+
+    CsvOptions blockOptions = options;
+    while (!eof || pending > 0) {
+        // 남은 줄 조각 뒤에 이어서 읽는다
+        if (!eof) {
+            const std::size_t wanted = buffer.size() - pending;
+            std::size_t got = 0;
+            while (got < wanted) {
+                const std::size_t n = stream->read(buffer.data() + pending + got, wanted - got);
+                if (n == 0) break;
+                got += n;
+            }
+            if (got < wanted) {
+                failure = stream->error();
+                if (!failure.empty()) {
+                    return false;
+                }
+                eof = true;
+            }
+            pending += got;
+        }
+
+        // 마지막 줄바꿈까지만 파싱하고 나머지는 다음 읽기로 넘긴다
+        std::size_t end = pending;
+        if (!eof) {
+            const char *begin = buffer.data();
+            const char *p = begin + pending;
+            while (p > begin && p[-1] != '\n') p--;
+            if (p == begin) {
+                // 버퍼보다 긴 줄: 버퍼를 키워서 다시 읽는다
+                buffer.resize(buffer.size() * 2);
+                continue;
+            }
+            end = static_cast<std::size_t>(p - begin);
+        }
+
+        blockOptions.skipHeader = headerPending;
+        const CsvStats block = parseCsv(buffer.data(), end, blockOptions, chunk);
+
+        // 블록 안 줄 번호를 파일 기준으로
+        for (std::size_t line : block.rejectedLines) {
+            if (stats.rejectedLines.size() >= options.maxRejectedLines) break;
+            stats.rejectedLines.push_back(lineNumber - 1 + line);
+        }
+        stats.rows += block.rows;
+        stats.rejectedRows += block.rejectedRows;
+        lineNumber += block.rows + (headerPending ? 1 : 0);
+        headerPending = false;
+
+        consumed += end;
+        std::memmove(buffer.data(), buffer.data() + end, pending - end);
+        pending -= end;
+
+        if (!chunk.empty()) {
+            points += chunk.size();
+            return true;
+        }
+    }
+    return false;
+}
+
+PointStreamChunkSource::PointStreamChunkSource(std::size_t chunkRows)
+    : chunkRows(std::max<std::size_t>(chunkRows, 1))
+{
+}
+
+bool PointStreamChunkSource::open(const std::string &path, std::string *error)
+{
+    if (!reader.open(path, error)) {
+        return false;
+    }
+    if (reader.header().columns < 2) {
+        if (error) *error = "Point stream has fewer than 2 columns: " + path;
+        reader.close();
+        return false;
+    }
+    this->path = path;
+    fileSize = fileSizeOf(path);
+    points = 0;
+    failure.clear();
+    rows.resize(chunkRows * reader.header().columns);
+    return true;
+}
+
+bool PointStreamChunkSource::rewind()
+{
+    std::string error;
+    if (!open(path, &error)) {
+        failure = error;
+        return false;
+    }
+    return true;
+}
+
+bool PointStreamChunkSource::next(PointSet &chunk)
+{
+    chunk.clear();
+
+    const std::size_t count = reader.readRows(rows.data(), chunkRows);
+    if (count == 0) {
+        failure = reader.error();
+        return false;
+    }
+
+    // 행 우선 -> 열 (SoA)
+    const std::size_t columns = reader.header().columns;
+    chunk.x.resize(count);
+    chunk.y.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        chunk.x[i] = rows[i * columns];
+        chunk.y[i] = rows[i * columns + 1];
+    }
+    points += count;
+    return true;
+}
+
+std::unique_ptr<PointChunkSource> openPointSource(const std::string &path, const CsvOptions &options,
+                                                  std::string *error)
+{
+    if (hasExtension(stripCompressionExtension(path), ".vpts")) {
+        std::unique_ptr<PointStreamChunkSource> source(new PointStreamChunkSource());
+        if (!source->open(path, error)) return nullptr;
+        return source;
+    }
+
+    std::unique_ptr<CsvChunkSource> source(new CsvChunkSource(options));
+    if (!source->open(path, error)) return nullptr;
+    return source;
+}
+
+} // namespace vision
@@ -0,0 +1,113 @@
+#ifndef VISION_POINT_SOURCE_H
+#define VISION_POINT_SOURCE_H
+
+#include "byte_stream.h"
+#include "csv_loader.h"
+#include "point_set.h"
+#include "point_stream.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+// 파일 전체를 메모리에 올리지 않고 점을 청크 단위로 넘겨주는 입력.
+// 여러 번 훑는 알고리즘(k-means 등)을 위해 처음으로 되돌릴 수 있다.
+class PointChunkSource
+{
+public:
+    virtual ~PointChunkSource() = default;
+
+    // chunk 를 비우고 다음 점들로 채운다. 끝이거나 읽기 오류면 false.
+    // 청크 크기는 구현이 정한 상한을 넘지 않는다.
+    virtual bool next(PointSet &chunk) = 0;
+
+    // 처음부터 다시 읽기
+    virtual bool rewind() = 0;
+
+    // 읽기 오류가 있었으면 메시지, 없으면 빈 문자열
+    virtual std::string error() const = 0;
+
+    // 지금까지 읽은 입력 바이트 수 (진행률용)와 전체 크기 (모르면 0).
+    // 압축 파일이면 둘 다 압축된 크기 기준이다.
+    virtual std::size_t bytesRead() const = 0;
+    virtual std::size_t totalBytes() const = 0;
+
+    // 이번 패스에서 지금까지 넘겨준 점 수
+    std::size_t pointsRead() const { return points; }
+
+protected:
+    std::size_t points = 0;
+};
+
+// CSV 를 고정 크기 버퍼로 읽으며 줄 단위로 파싱한다.
+// 헤더는 파일 첫 줄에서만 건너뛰고, 잘못된 행 줄 번호는 파일 기준이다.
+// gzip / zstd 파일은 별도 스레드에서 압축을 풀며 읽는다 (openByteStream).
+class CsvChunkSource : public PointChunkSource
+{
+public:
+    explicit CsvChunkSource(const CsvOptions &options = CsvOptions(),
+                            std::size_t bufferBytes = 16 << 20);
+    ~CsvChunkSource() override;
+
+    bool open(const std::string &path, std::string *error = nullptr);
+    void close();
+
+    bool next(PointSet &chunk) override;
+    bool rewind() override;
+    std::string error() const override { return failure; }
+    std::size_t bytesRead() const override;
+    std::size_t totalBytes() const override { return fileSize; }
+
+    // 지금까지 읽은 행 통계 (rewind 하면 처음부터 다시 센다)
+    const CsvStats &csvStats() const { return stats; }
+
+private:
+    CsvOptions options;
+    std::unique_ptr<ByteStream> stream;
+    Compression compression = Compression::None;
+    std::string path;
+    std::vector<char> buffer;
+    std::size_t pending = 0;  // buffer 앞부분에 남은 끝나지 않은 줄
+    std::size_t consumed = 0;
+    std::size_t fileSize = 0;
+    std::size_t lineNumber = 1;
+    bool headerPending = false;
+    bool eof = false;
+    std::string failure;
+    CsvStats stats;
+};
+
+// .vpts 에서 앞의 두 열을 x, y 로 읽는다
+class PointStreamChunkSource : public PointChunkSource
+{
+public:
+    explicit PointStreamChunkSource(std::size_t chunkRows = 1 << 20);
+
+    bool open(const std::string &path, std::string *error = nullptr);
+
+    bool next(PointSet &chunk) override;
+    bool rewind() override;
+    std::string error() const override { return failure; }
+    std::size_t bytesRead() const override { return reader.sourceBytesRead(); }
+    std::size_t totalBytes() const override { return fileSize; }
+
+private:
+    PointStreamReader reader;
+    std::string path;
+    std::size_t chunkRows;
+    std::vector<double> rows;
+    std::size_t fileSize = 0;
+    std::string failure;
+};
+
+// 확장자(.vpts 또는 그 외 CSV)로 골라서 연다. .gz / .zst 는 떼고 본다. 실패하면 nullptr.
+std::unique_ptr<PointChunkSource> openPointSource(const std::string &path,
+                                                  const CsvOptions &options = CsvOptions(),
+                                                  std::string *error = nullptr);
+
+} // namespace vision
+
+#endif // VISION_POINT_SOURCE_H
@@ -0,0 +1,162 @@
+#include "point_stream.h"
+
+#include <cstring>
+
+namespace vision {
+
+namespace {
+
+// 한 번에 fwrite 하는 크기 (double 개수)
+const std::size_t writeBufferValues = 1 << 17;
+
+} // namespace
+
+PointStreamWriter::~PointStreamWriter()
+{
+    close();
+}
+
+bool PointStreamWriter::open(const std::string &path, const PointStreamHeader &header)
+{
+    close();
+
+    if (path == "-") {
+        file = stdout;
+        ownsFile = false;
+    } else {
+        file = std::fopen(path.c_str(), "wb");
+        ownsFile = true;
+    }
+    if (!file) {
+        return false;
+    }
+
+    failed = std::fwrite(&header, sizeof(header), 1, file) != 1;
+    columns = header.columns;
+    buffer.clear();
+    buffer.reserve(writeBufferValues + columns);
+    return !failed;
+}
+
+void PointStreamWriter::writeRow(const double *values)
+{
+    buffer.insert(buffer.end(), values, values + columns);
+    if (buffer.size() >= writeBufferValues) {
+        flush();
+    }
+}
+
+void PointStreamWriter::flush()
+{
+    if (!buffer.empty() && std::fwrite(buffer.data(), sizeof(double), buffer.size(), file) != buffer.size()) {
+        failed = true;
+    }
+    buffer.clear();
+}
+
+bool PointStreamWriter::close()
+{
+    if (!file) {
+        return !failed;
+    }
+
+    flush();
+    if (std::fflush(file) != 0) failed = true;
+    if (ownsFile && std::fclose(file) != 0) failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+PointStreamReader::~PointStreamReader()
+{
+    close();
+}
+
+bool PointStreamReader::open(const std::string &path, std::string *error)
+{
+    close();
+
+    // .vpts.gz / .vpts.zst 도 같은 방식으로 읽는다
+    stream = openByteStream(path, error);
+    if (!stream) {
+        return false;
+    }
+
+    if (!readFull(reinterpret_cast<char *>(&info), sizeof(info)) ||
+        std::memcmp(info.magic, "VPTS", 4) != 0 || info.version != 1 || info.columns == 0) {
+        if (error) *error = "Not a point stream file: " + path;
+        close();
+        return false;
+    }
+
+    rowsRead = 0;
+    return true;
+}
+
+void PointStreamReader::close()
+{
+    stream.reset();
+    failure.clear();
+}
+
+std::string PointStreamReader::error() const
+{
+    // 압축 해제 오류가 있으면 그쪽이 원인
+    if (stream && !stream->error().empty()) {
+        return stream->error();
+    }
+    return failure;
+}
+
+std::size_t PointStreamReader::sourceBytesRead() const
+{
+    return stream ? stream->sourceBytesRead() : 0;
+}
+
+bool PointStreamReader::readFull(char *data, std::size_t size)
+{
+    std::size_t filled = 0;
+    while (filled < size) {
+        const std::size_t got = stream->read(data + filled, size - filled);
+        if (got == 0) break;
+        filled += got;
+    }
+    return filled == size;
+}
+
+std::size_t PointStreamReader::readRows(double *values, std::size_t maxRows)
+{
+    if (!stream) {
+        return 0;
+    }
+    if (info.rows != 0 && rowsRead + maxRows > info.rows) {
+        maxRows = static_cast<std::size_t>(info.rows - rowsRead);
+    }
+
+    // 압축 스트림은 요청보다 적게 줄 수 있으므로 행 경계까지 채운다
+    const std::size_t rowBytes = sizeof(double) * info.columns;
+    char *bytes = reinterpret_cast<char *>(values);
+    std::size_t filled = 0;
+    while (filled < maxRows * rowBytes) {
+        const std::size_t got = stream->read(bytes + filled, maxRows * rowBytes - filled);
+        if (got == 0) break;
+        filled += got;
+    }
+
+    const std::size_t rows = filled / rowBytes;
+    rowsRead += rows;
+
+    // 요청만큼 못 채웠으면 스트림 끝. 행 중간에서 끝났거나 헤더의 행 수보다
+    // 적으면 잘린 파일이다. 일부 데이터로 조용히 맞추지 않도록 오류로 남긴다.
+    if (filled < maxRows * rowBytes && failure.empty()) {
+        if (filled % rowBytes != 0) {
+            failure = "Truncated point stream: partial row after row " + std::to_string(rowsRead);
+        } else if (info.rows != 0 && rowsRead < info.rows) {
+            failure = "Truncated point stream: " + std::to_string(rowsRead) + " of " +
+                      std::to_string(info.rows) + " rows";
+        }
+    }
+    return rows;
+}
+
+} // namespace vision
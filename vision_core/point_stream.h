@@ -0,0 +1,89 @@
+#ifndef VISION_POINT_STREAM_H
+#define VISION_POINT_STREAM_H
+
+#include "byte_stream.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+// .vpts: 행 단위로 float64 를 이어 붙인 바이너리 점 스트림 (little endian).
+// 헤더 뒤에 rows * columns 개의 double 이 온다. 앞에서부터 순서대로 읽고
+// 쓰기만 하므로 데이터 크기와 관계없이 고정된 메모리로 처리할 수 있다.
+struct PointStreamHeader {
+    char magic[4] = {'V', 'P', 'T', 'S'};
+    std::uint32_t version = 1;
+    std::uint32_t columns = 2;
+    std::uint32_t flags = 0;
+    std::uint64_t rows = 0;  // 0 이면 파일 끝까지
+};
+static_assert(sizeof(PointStreamHeader) == 24, "PointStreamHeader layout");
+
+enum PointStreamFlags : std::uint32_t {
+    PointStreamHasLabel = 1u << 0,  // 마지막 열이 라벨
+};
+
+class PointStreamWriter
+{
+public:
+    PointStreamWriter() = default;
+    ~PointStreamWriter();
+
+    PointStreamWriter(const PointStreamWriter &) = delete;
+    PointStreamWriter &operator=(const PointStreamWriter &) = delete;
+
+    // path 가 "-" 이면 stdout
+    bool open(const std::string &path, const PointStreamHeader &header);
+    void writeRow(const double *values);
+    bool close();
+
+private:
+    void flush();
+
+    std::FILE *file = nullptr;
+    bool ownsFile = false;
+    bool failed = false;
+    std::uint32_t columns = 0;
+    std::vector<double> buffer;
+};
+
+class PointStreamReader
+{
+public:
+    PointStreamReader() = default;
+    ~PointStreamReader();
+
+    PointStreamReader(const PointStreamReader &) = delete;
+    PointStreamReader &operator=(const PointStreamReader &) = delete;
+
+    bool open(const std::string &path, std::string *error = nullptr);
+    void close();
+
+    const PointStreamHeader &header() const { return info; }
+
+    // 최대 maxRows 행을 values 에 행 우선으로 읽는다. 0 이면 끝 (잘린 파일이면 error() 가 채워진다).
+    std::size_t readRows(double *values, std::size_t maxRows);
+
+    // 원본 파일에서 읽은 바이트 (압축 파일이면 압축된 크기 기준)
+    std::size_t sourceBytesRead() const;
+
+    // 끝이 아닌데 멈췄거나 파일이 행 중간 / 헤더의 행 수보다 먼저 끝났으면 오류 메시지
+    std::string error() const;
+
+private:
+    bool readFull(char *data, std::size_t size);
+
+    std::unique_ptr<ByteStream> stream;
+    PointStreamHeader info;
+    std::uint64_t rowsRead = 0;
+    std::string failure;
+};
+
+} // namespace vision
+
+#endif // VISION_POINT_STREAM_H
@@ -0,0 +1,169 @@
+#include "preemptive_ransac.h"
+#include "inlier_kernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace vision {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Candidate {
+    LineModel line;
+    double limit = 0;       // threshold * sqrt(a^2 + 1)
+    std::size_t score = 0;  // 지금까지 채점한 점 중 inlier 수
+    int index = 0;          // 동점일 때 순서를 정하는 가설 번호
+};
+
+// 점수가 높은 순, 동점이면 먼저 만든 가설
+bool betterCandidate(const Candidate &lhs, const Candidate &rhs)
+{
+    if (lhs.score != rhs.score) return lhs.score > rhs.score;
+    return lhs.index < rhs.index;
+}
+
+double elapsedMicros(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+} // namespace
+
+PreemptiveRansacResult preemptiveRansac(const PointView &points,
+                                        const PreemptiveRansacParams &params, Stats *stats)
+{
+    VISION_STAT_TIMER(stats, Stage::Ransac);
+    const Clock::time_point start = Clock::now();
+    const double budget = static_cast<double>(params.budgetMicros);
+    auto outOfTime = [&] { return budget > 0 && elapsedMicros(start) >= budget; };
+
+    PreemptiveRansacResult result;
+    if (points.size < 2 || params.hypotheses < 1) {
+        return result;
+    }
+
+    std::mt19937_64 generator(params.seed);
+    std::uniform_int_distribution<std::size_t> pick(0, points.size - 1);
+
+    // 1. 가설 M 개를 한꺼번에 만든다
+    std::vector<Candidate> candidates;
+    candidates.reserve(params.hypotheses);
+    for (int i = 0; i < params.hypotheses; i++) {
+        result.hypotheses++;
+        VISION_STAT_ADD(stats, hypothesesGenerated, 1);
+
+        const std::size_t idx1 = pick(generator);
+        const std::size_t idx2 = pick(generator);
+        const double x1 = points.x[idx1], y1 = points.y[idx1];
+        const double x2 = points.x[idx2], y2 = points.y[idx2];
+        if (idx1 == idx2 || std::abs(x2 - x1) < 0.0001) {
+            VISION_STAT_ADD(stats, hypothesesDegenerate, 1);
+            continue;
+        }
+
+        Candidate candidate;
+        candidate.line.a = (y2 - y1) / (x2 - x1);
+        candidate.line.b = y1 - candidate.line.a * x1;
+        candidate.limit = inlierLimit(candidate.line, params.threshold);
+        candidate.index = i;
+        candidates.push_back(candidate);
+    }
+    VISION_STAT_ADD(stats, hypothesesEvaluated, candidates.size());
+    if (candidates.empty()) {
+        result.elapsedMicros = elapsedMicros(start);
+        return result;
+    }
+
+    // 2. 점 방문 순서: start + k * stride (mod n). stride 가 n 과 서로소이면 모든 점을
+    //    한 번씩 방문하므로 순열 배열을 만들지 않아도 된다
+    const std::size_t n = points.size;
+    std::size_t stride = 1;
+    if (n > 2) {
+        std::uniform_int_distribution<std::size_t> pickStride(1, n - 1);
+        do {
+            stride = pickStride(generator);
+        } while (std::gcd(stride, n) != 1);
+    }
+    const std::size_t first = pick(generator);
+    auto advance = [&](std::size_t position) {
+        position += stride;  // 둘 다 n 보다 작아서 넘치지 않는다
+        return position >= n ? position - n : position;
+    };
+    std::size_t cursor = first;
+
+    // 3. 블록마다 모든 생존 가설을 채점하고 약한 절반씩 버린다
+    const std::size_t blockSize = std::max<std::size_t>(1, params.blockSize);
+    const InlierCountKernel kernel = inlierCountKernel();
+    std::vector<double> blockX(blockSize), blockY(blockSize);
+    std::size_t survivors = candidates.size();
+    std::size_t scored = 0;
+    int halvings = 0;
+
+    while (survivors > 1 && scored < n) {
+        if (outOfTime()) {
+            result.budgetExceeded = true;
+            break;
+        }
+
+        // 방문 순서대로 연속 버퍼에 모아서 SIMD 커널로 센다
+        const std::size_t count = std::min(blockSize, n - scored);
+        for (std::size_t k = 0; k < count; k++) {
+            blockX[k] = points.x[cursor];
+            blockY[k] = points.y[cursor];
+            cursor = advance(cursor);
+        }
+        for (std::size_t c = 0; c < survivors; c++) {
+            Candidate &candidate = candidates[c];
+            candidate.score += kernel(blockX.data(), blockY.data(), count, candidate.line.a,
+                                      candidate.line.b, candidate.limit);
+        }
+        VISION_STAT_ADD(stats, inlierTests, count * survivors);
+        scored += count;
+
+        // f(i) = floor(M * 2^-floor(i / B))
+        const int nextHalvings = static_cast<int>(std::min<std::size_t>(scored / blockSize, 62));
+        if (nextHalvings != halvings) {
+            halvings = nextHalvings;
+            const std::size_t keep = std::max<std::size_t>(
+                1, static_cast<std::size_t>(params.hypotheses) >> halvings);
+            if (keep < survivors) {
+                std::nth_element(candidates.begin(), candidates.begin() + (keep - 1),
+                                 candidates.begin() + survivors, betterCandidate);
+                survivors = keep;
+            }
+        }
+    }
+
+    const Candidate &best = *std::min_element(candidates.begin(), candidates.begin() + survivors,
+                                              betterCandidate);
+    result.survivors = static_cast<int>(survivors);
+    result.scoredPoints = scored;
+
+    // 4. 채점한 점 중 최적 가설의 inlier 로 재추정 (채점 전에 시간이 다 됐으면 첫 블록)
+    {
+        VISION_STAT_TIMER(stats, Stage::Refit);
+        VISION_STAT_ADD(stats, modelRefits, 1);
+        const std::size_t refitPoints = std::max(scored, std::min(blockSize, n));
+        VISION_STAT_ADD(stats, inlierTests, refitPoints);
+        result.inliers.reserve(std::min(refitPoints, best.score + blockSize));
+        std::size_t idx = first;
+        for (std::size_t k = 0; k < refitPoints; k++, idx = advance(idx)) {
+            if (std::abs(best.line.a * points.x[idx] - points.y[idx] + best.line.b) < best.limit) {
+                result.inliers.push_back(idx);
+            }
+        }
+        result.model = result.inliers.size() >= 2
+                           ? fitLineLeastSquares(points, result.inliers.data(), result.inliers.size())
+                           : best.line;
+    }
+
+    result.elapsedMicros = elapsedMicros(start);
+    return result;
+}
+
+} // namespace vision
@@ -0,0 +1,46 @@
+#ifndef VISION_PREEMPTIVE_RANSAC_H
+#define VISION_PREEMPTIVE_RANSAC_H
+
+#include "line_fit.h"
+#include "point_set.h"
+#include "stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vision {
+
+// 실시간용 preemptive RANSAC (Nistér 2003).
+// 가설 M 개를 먼저 만들고, 점을 blockSize 개씩 모든 생존 가설에 동시에(너비 우선)
+// 채점한다. i 개의 점을 본 뒤에는 점수가 높은 M * 2^-floor(i / blockSize) 개만
+// 남기므로 전체 작업량이 데이터 크기가 아니라 M 과 blockSize 로 정해진다.
+struct PreemptiveRansacParams {
+    int hypotheses = 500;        // 처음에 만드는 가설 수 M
+    std::size_t blockSize = 100; // 가지치기 사이에 채점하는 점 수 B
+    double threshold = 200.0;    // inlier 판단 거리
+    std::uint64_t seed = 1;      // 같은 seed면 같은 결과 (시간 제한에 걸리지 않았을 때)
+    // 0 보다 크면 이 시간(마이크로초)이 지나면 블록 경계에서 멈추고 그때까지의
+    // 최고 점수 가설을 쓴다
+    std::int64_t budgetMicros = 0;
+};
+
+struct PreemptiveRansacResult {
+    LineModel model;                   // 채점한 점 중 inlier 로 재추정한 모델
+    std::vector<std::size_t> inliers;  // 채점한 점 중 최적 가설의 inlier 인덱스 (방문 순서)
+    int hypotheses = 0;                // 실제로 만든 가설 수
+    int survivors = 0;                 // 끝났을 때 남은 가설 수
+    std::size_t scoredPoints = 0;      // 채점에 쓴 점 수
+    bool budgetExceeded = false;       // 시간 제한으로 일찍 멈췄는지
+    double elapsedMicros = 0;
+};
+
+// 점은 겹치지 않는 무작위 순서로 방문한다. 재추정은 채점한 점에서만 하므로
+// 전체 점을 다시 훑지 않는다.
+PreemptiveRansacResult preemptiveRansac(const PointView &points,
+                                        const PreemptiveRansacParams &params = PreemptiveRansacParams(),
+                                        Stats *stats = nullptr);
+
+} // namespace vision
+
+#endif // VISION_PREEMPTIVE_RANSAC_H
@@ -0,0 +1,717 @@
+#include "ransac.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace vision {
+
+int requiredIterations(double inlierRatio, double confidence, int sampleSize)
+{
+    if (confidence <= 0.0) return 0;
+    const double good = std::pow(std::clamp(inlierRatio, 0.0, 1.0), sampleSize);
+    if (good >= 1.0) return 1;
+    if (good <= 0.0 || confidence >= 1.0) return INT_MAX;
+
+    // log1p 로 w^s 가 아주 작을 때도 정밀도를 잃지 않는다
+    const double n = std::ceil(std::log1p(-confidence) / std::log1p(-good));
+    return n >= INT_MAX ? INT_MAX : std::max(1, static_cast<int>(n));
+}
+
+double achievedConfidence(double inlierRatio, int iterations, int sampleSize)
+{
+    const double good = std::pow(std::clamp(inlierRatio, 0.0, 1.0), sampleSize);
+    if (good >= 1.0) return iterations > 0 ? 1.0 : 0.0;
+    return -std::expm1(iterations * std::log1p(-good));
+}
+
+namespace {
+
+// 가설 번호마다 난수열을 바로 만들 수 있는 가벼운 생성기 (splitmix64).
+// mt19937_64 는 seed 하는 비용이 커서 가설마다 새로 만들기 어렵다.
+struct SplitMix64 {
+    using result_type = std::uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()()
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t state;
+};
+
+// 가설 점수 (낮을수록 좋다). 가설마다 inlier 수와 inlier 거리 제곱합만 있으면 되므로
+// 세 방식 모두 inlier_kernel 의 한 번의 패스로 구한다. InlierCount 는 -inlier 수.
+const double mlesacSigmaRatio = 1.96;  // MLESAC: threshold 안에 inlier 의 95%
+const double logSqrtTwoPi = 0.91893853320467274178;  // log(√(2π))
+
+class HypothesisScorer
+{
+public:
+    HypothesisScorer(const PointView &points, const RansacParams &params)
+        : scoring(params.scoring)
+        , threshold(params.threshold)
+        , outlierCost(params.threshold * params.threshold)
+    {
+        if (scoring != RansacScoring::Mlesac || points.size == 0) {
+            return;
+        }
+        // outlier 거리는 점 범위 안에 고르게 퍼진다고 본다 (실행마다 한 번)
+        double minX = points.x[0], maxX = points.x[0], minY = points.y[0], maxY = points.y[0];
+        for (std::size_t i = 1; i < points.size; i++) {
+            minX = std::min(minX, points.x[i]);
+            maxX = std::max(maxX, points.x[i]);
+            minY = std::min(minY, points.y[i]);
+            maxY = std::max(maxY, points.y[i]);
+        }
+        const double spread = std::max(std::hypot(maxX - minX, maxY - minY), 2 * threshold);
+        const double sigma = threshold / mlesacSigmaRatio;
+        inlierScale = 1 / (2 * sigma * sigma);
+        inlierBase = logSqrtTwoPi + std::log(sigma);
+        outlierBase = std::log(spread);
+    }
+
+    bool usesResiduals() const { return scoring != RansacScoring::InlierCount; }
+
+    // MSAC 에서 outlier 한 점의 비용 threshold^2 (SPRT 의 하한 판정용, 아니면 0)
+    double msacOutlierCost() const { return scoring == RansacScoring::Msac ? outlierCost : 0; }
+
+    // total 개 중 count 개가 inlier 이고 inlier 거리 제곱합이 squaredSum 일 때
+    double cost(std::size_t count, double squaredSum, std::size_t total) const
+    {
+        switch (scoring) {
+            case RansacScoring::InlierCount:
+                return -static_cast<double>(count);
+            case RansacScoring::Msac:
+                return squaredSum + static_cast<double>(total - count) * outlierCost;
+            case RansacScoring::Mlesac: {
+                // -log L = sum_in (d^2 / 2σ^2 + log(√(2π) σ) - log γ) + sum_out (log ν - log(1 - γ))
+                const double gamma = total > 0 ? static_cast<double>(count) / total : 0;
+                double result = squaredSum * inlierScale;
+                if (count > 0) {
+                    result += count * (inlierBase - std::log(gamma));
+                }
+                if (count < total) {
+                    result += (total - count) * (outlierBase - std::log1p(-gamma));
+                }
+                return result;
+            }
+        }
+        return 0;
+    }
+
+    // points 에서 model 의 점수와 inlier 수를 한 번에 구한다
+    double evaluate(const PointView &points, const LineModel &model, std::size_t &count) const
+    {
+        if (!usesResiduals()) {
+            count = countInliers(points, model, threshold);
+            return cost(count, 0, points.size);
+        }
+        const InlierScore score = scoreInliers(points, model, threshold);
+        count = score.count;
+        return cost(score.count, score.squaredSum, points.size);
+    }
+
+private:
+    RansacScoring scoring;
+    double threshold;
+    double outlierCost;       // MSAC: threshold^2
+    double inlierScale = 0;   // MLESAC: 1 / 2σ^2
+    double inlierBase = 0;    // MLESAC: log(√(2π) σ)
+    double outlierBase = 0;   // MLESAC: log ν (ν = 점 범위)
+};
+
+// SPRT (Matas & Chum, "Randomized RANSAC with Sequential Probability Ratio Test").
+// 좋은 모델에서 점이 inlier 일 확률 ε, 나쁜 모델에서의 확률 δ 로 우도비 λ 를
+// 점마다 곱해 가다가 A 를 넘으면 그 가설을 버린다.
+
+const double sprtInitialDelta = 0.05;  // 나쁜 가설의 inlier 비율 초기값 (이후 관찰로 갱신)
+const double sprtModelCost = 50.0;     // 가설 하나를 만드는 비용 (점 판정 횟수 단위)
+const std::size_t sprtChunk = 64;      // λ 를 확인하는 간격 (SIMD 커널로 한 번에 세는 점 수)
+const int sprtMaxBlock = 64;           // 블록은 1, 2, 4, ... 64 로 커진다
+
+// 판정 한계 A. A = K + log A (K = t_M * C + 1) 를 고정점 반복으로 푼다
+double sprtThreshold(double epsilon, double delta)
+{
+    const double c = (1 - delta) * std::log((1 - delta) / (1 - epsilon)) +
+                     delta * std::log(delta / epsilon);
+    const double k = sprtModelCost * c + 1;
+    double a = k;
+    for (int i = 0; i < 50; i++) {
+        const double next = k + std::log(a);
+        if (std::abs(next - a) < 1e-6) break;
+        a = next;
+    }
+    return a;
+}
+
+// 블록 하나를 평가하는 동안 모든 스레드가 같은 값을 보도록 고정한 판정 값
+struct SprtTest {
+    bool active = false;           // 아직 최적 모델이 없거나 ε <= δ 면 끝까지 센다
+    double logInlier = 0;          // inlier 한 점마다 log λ 에 더함: log(δ / ε)
+    double logOutlier = 0;         // outlier: log((1 - δ) / (1 - ε))
+    double logThreshold = 0;       // log A
+    std::size_t bestCount = 0;     // 남은 점이 전부 inlier 여도 이걸 넘지 못하면 버린다
+    // MSAC: 본 점의 비용 (inlier 거리 제곱 + outlier 마다 outlierCost) 이 bestCost 에
+    // 닿으면 남은 점이 모두 거리 0 이어도 이길 수 없다. outlierCost 가 0 이면 쓰지 않음
+    double bestCost = 0;
+    double outlierCost = 0;
+};
+
+// ε, δ 를 관찰로 갱신하며 SprtTest 를 만든다
+struct SprtState {
+    double epsilon = 0;
+    double delta = sprtInitialDelta;
+    double threshold = 0;          // A (epsilon 이 0 이면 의미 없음)
+    double deltaSum = 0;           // 버린 가설들이 본 점 중 inlier 비율의 합
+    std::size_t deltaCount = 0;
+
+    void update()
+    {
+        threshold = epsilon > delta ? sprtThreshold(epsilon, delta) : 0;
+    }
+
+    SprtTest test(std::size_t bestCount) const
+    {
+        SprtTest result;
+        result.bestCount = bestCount;
+        if (threshold > 1) {
+            result.active = true;
+            result.logInlier = std::log(delta / epsilon);
+            result.logOutlier = std::log((1 - delta) / (1 - epsilon));
+            result.logThreshold = std::log(threshold);
+        }
+        return result;
+    }
+
+    // 좋은 가설이 버려지지 않을 확률 (약 1 - 1/A). 종료 조건의 inlier 확률에 곱한다
+    double acceptance() const
+    {
+        return threshold > 1 ? 1 - 1 / threshold : 1;
+    }
+};
+
+// PROSAC (Chum & Matas, "Matching with PROSAC"). 순위가 높은 점 n 개 U_n 에서만
+// 뽑다가 반복이 늘면 n 을 키운다. n 이 전체가 되면 균등 RANSAC 과 같다.
+// 성장 속도는 균등 샘플링 prosacGrowthLimit 번과 같은 분포가 되도록 정한다.
+const double prosacGrowthLimit = 200000.0;
+
+// rankByDensity 가 정렬하는 앞쪽 점 수. 그 뒤는 순서가 없다
+const std::size_t rankDensitySorted = 1 << 16;
+
+// 가설 번호 순서대로 부르면 그 가설이 뽑을 집합 크기를 정한다.
+// 결과에 의존하지 않으므로 블록을 나누기 전에 메인 스레드에서 미리 정한다.
+class ProsacSchedule
+{
+public:
+    explicit ProsacSchedule(std::size_t count)
+        : total(count)
+    {
+        // T_2 = T_N * 2 / (N (N - 1))
+        samples = prosacGrowthLimit * 2.0 / (static_cast<double>(count) * (count - 1));
+    }
+
+    // t 번째 (1부터) 가설: U_subset 에서 뽑는다. withNth 면 subset 번째 점을 꼭 넣는다
+    void next(std::uint64_t t, std::size_t &subset, bool &withNth)
+    {
+        if (static_cast<double>(t) > growth && size < total) {
+            // T_{n+1} = T_n (n + 1) / (n + 1 - m),  T'_{n+1} = T'_n + ceil(T_{n+1} - T_n)
+            const double nextSamples = samples * (size + 1) / (size + 1 - 2);
+            growth += std::ceil(nextSamples - samples);
+            samples = nextSamples;
+            size++;
+        }
+        subset = size;
+        withNth = growth >= static_cast<double>(t) && size < total;
+    }
+
+private:
+    std::size_t total;
+    std::size_t size = 2;   // n
+    double samples;         // T_n
+    double growth = 1;      // T'_n
+};
+
+// LO-RANSAC (Chum, Matas & Kittler 의 local optimization, 반복 최소제곱은 Lebeda 등의 LO+).
+// 새 최적 가설이 나올 때만, 그 모델 주변 점에서 최소 샘플보다 큰 샘플을 다시 뽑아
+// 최소제곱으로 맞추고 임계값을 줄여 가며 재추정한다. 내부 작업은 무작위 순서로
+// 모은 주변 점 최대 loMaxPoints 개에서만 하고, 전체 점은 이긴 후보를 다시 셀 때
+// 한 번만 훑는다.
+const int loInnerIterations = 10;       // inlier 에서 다시 뽑는 횟수
+const std::size_t loSampleSize = 14;    // 내부 샘플 크기 (최소 샘플의 7배)
+const int loRefitSteps = 4;             // 임계값을 loThresholdScale 배에서 1배로 줄이며 재추정
+const double loThresholdScale = 3.0;
+const std::size_t loMaxPoints = 8192;   // 내부 작업에 쓰는 주변 점 수 상한
+
+// 모델 주변 점의 부분 표본. 실행마다 재사용한다
+struct LocalSample {
+    PointSet points;                  // loThresholdScale * threshold 안의 점 (SoA)
+    std::vector<std::size_t> inliers; // points 중 threshold 안의 인덱스
+};
+
+// model 의 inlier 만으로 최소제곱 합을 모은다 (인덱스를 만들지 않음)
+LineMoments inlierMoments(const PointView &points, const LineModel &model, double threshold)
+{
+    const double limit = inlierLimit(model, threshold);
+    LineMoments moments;
+    for (std::size_t i = 0; i < points.size; i++) {
+        if (std::abs(model.a * points.x[i] - points.y[i] + model.b) < limit) {
+            moments.add(points.x[i], points.y[i]);
+        }
+    }
+    return moments;
+}
+
+// model / count / cost 를 점수가 더 좋은 모델로 바꾼다
+void localOptimize(const PointView &points, const HypothesisScorer &scorer, double threshold,
+                   std::uint64_t seed, LineModel &model, std::size_t &count, double &cost,
+                   LocalSample &local, Stats *stats)
+{
+    VISION_STAT_TIMER(stats, Stage::Refit);
+    SplitMix64 generator{seed};
+
+    // 1. 점을 무작위 순서 (start + k * stride, stride 는 n 과 서로소) 로 보면서 넓은
+    //    임계값 안의 점을 loMaxPoints 개까지 모은다. 주변 점이 많으면 전체를 다 보지 않는다
+    const std::size_t n = points.size;
+    std::size_t stride = 1;
+    if (n > 2) {
+        std::uniform_int_distribution<std::size_t> pickStride(1, n - 1);
+        do {
+            stride = pickStride(generator);
+        } while (std::gcd(stride, n) != 1);
+    }
+    const double a = model.a, b = model.b;
+    const double wideLimit = inlierLimit(model, threshold * loThresholdScale);
+    local.points.clear();
+    std::size_t idx = std::uniform_int_distribution<std::size_t>(0, n - 1)(generator);
+    std::size_t visited = 0;
+    for (; visited < n && local.points.size() < loMaxPoints; visited++) {
+        if (std::abs(a * points.x[idx] - points.y[idx] + b) < wideLimit) {
+            local.points.append(points.x[idx], points.y[idx]);
+        }
+        idx += stride;
+        if (idx >= n) idx -= n;
+    }
+    VISION_STAT_ADD(stats, inlierTests, visited);
+    const PointView view = local.points.view();
+    collectInliers(view, model, threshold, local.inliers);
+    if (local.inliers.size() < 2) {
+        return;
+    }
+
+    // 2. 표본의 inlier 에서 큰 샘플을 뽑아 최소제곱, 임계값을 줄여 가며 재추정하고
+    //    표본 안에서 점수가 가장 좋은 후보를 고른다
+    std::uniform_int_distribution<std::size_t> pickInlier(0, local.inliers.size() - 1);
+    const std::size_t sampleSize = std::min(loSampleSize, local.inliers.size());
+    std::size_t localCount;
+    const double modelLocal = scorer.evaluate(view, model, localCount);
+    LineModel bestCandidate = model;
+    double bestLocal = modelLocal;
+    for (int inner = 0; inner < loInnerIterations; inner++) {
+        LineMoments sample;
+        for (std::size_t k = 0; k < sampleSize; k++) {
+            const std::size_t idx = local.inliers[pickInlier(generator)];
+            sample.add(view.x[idx], view.y[idx]);
+        }
+        LineModel candidate = sample.solve();
+
+        for (int step = 0; step < loRefitSteps; step++) {
+            const double scale =
+                loThresholdScale - (loThresholdScale - 1) * step / (loRefitSteps - 1);
+            const LineMoments moments = inlierMoments(view, candidate, threshold * scale);
+            if (moments.n < 2) break;
+            candidate = moments.solve();
+        }
+        VISION_STAT_ADD(stats, modelRefits, loRefitSteps + 1);
+        VISION_STAT_ADD(stats, inlierTests, view.size * (loRefitSteps + 1));
+
+        const double candidateLocal = scorer.evaluate(view, candidate, localCount);
+        if (candidateLocal < bestLocal) {
+            bestLocal = candidateLocal;
+            bestCandidate = candidate;
+        }
+    }
+
+    // 3. 이긴 후보만 전체 점으로 다시 세어 나으면 바꾼다
+    if (bestLocal < modelLocal) {
+        VISION_STAT_ADD(stats, inlierTests, points.size);
+        std::size_t candidateCount;
+        const double candidateCost = scorer.evaluate(points, bestCandidate, candidateCount);
+        if (candidateCost < cost) {
+            model = bestCandidate;
+            count = candidateCount;
+            cost = candidateCost;
+        }
+    }
+}
+
+// 가설 하나를 만들고 inlier 수를 센 결과
+struct Hypothesis {
+    std::size_t subset = 0;   // PROSAC 이면 뽑을 상위 점 수 (입력)
+    bool withNth = false;     // PROSAC 이면 subset 번째 점을 꼭 넣음 (입력)
+
+    LineModel line;
+    std::size_t count = 0;    // rejected 면 tested 개 중 inlier 수
+    double cost = 0;          // HypothesisScorer 점수 (rejected 면 의미 없음)
+    std::size_t tested = 0;   // SPRT 로 판정한 점 수
+    bool degenerate = false;
+    bool rejected = false;    // SPRT 가 중간에 버림
+};
+
+void evaluateHypothesis(const PointView &points, const RansacParams &params,
+                        const HypothesisScorer &scorer, std::uint64_t index,
+                        const PointView &shuffled, const SprtTest *sprt, Hypothesis &out)
+{
+    // seed 로 만든 난수열의 index 번째 값을 이 가설의 시작 상태로 쓴다
+    SplitMix64 seeder{params.seed + index * 0x9E3779B97F4A7C15ULL};
+    SplitMix64 generator{seeder()};
+    std::uniform_int_distribution<std::size_t> pick(0, points.size - 1);
+
+    // 1. 무작위로 2개의 점 선택. PROSAC 이면 순위가 높은 점들 중에서
+    std::size_t idx1, idx2;
+    if (params.ranking) {
+        if (out.withNth) {
+            idx1 = params.ranking[out.subset - 1];
+            idx2 = params.ranking[std::uniform_int_distribution<std::size_t>(0, out.subset - 2)(generator)];
+        } else {
+            std::uniform_int_distribution<std::size_t> pickRanked(0, out.subset - 1);
+            idx1 = params.ranking[pickRanked(generator)];
+            idx2 = params.ranking[pickRanked(generator)];
+        }
+    } else {
+        idx1 = pick(generator);
+        idx2 = pick(generator);
+    }
+    out.degenerate = true;
+    out.rejected = false;
+    if (idx1 == idx2) return;
+
+    const double x1 = points.x[idx1], y1 = points.y[idx1];
+    const double x2 = points.x[idx2], y2 = points.y[idx2];
+
+    // 수직선 방지
+    if (std::abs(x2 - x1) < 0.0001) return;
+
+    // 2. 모델 파라미터 계산 (a, b)
+    out.degenerate = false;
+    out.line.a = (y2 - y1) / (x2 - x1);
+    out.line.b = y1 - out.line.a * x1;
+
+    // 3. 인라이어 수 세기 (점수가 잔차를 쓰면 같은 패스에서 거리 제곱합도)
+    if (!sprt) {
+        out.cost = scorer.evaluate(points, out.line, out.count);
+        out.tested = points.size;
+        return;
+    }
+
+    // SPRT: 섞어 둔 순서대로 sprtChunk 개씩 세면서 λ 를 갱신하고,
+    // 나쁜 가설이라는 증거가 충분하거나 최적 모델을 이길 수 없으면 멈춘다
+    static const InlierCountKernel countKernel = inlierCountKernel();
+    static const InlierScoreKernel scoreKernel = inlierScoreKernel();
+    const bool residuals = scorer.usesResiduals();
+    const double limit = inlierLimit(out.line, params.threshold);
+    const double distanceScale = out.line.a * out.line.a + 1;  // 잔차^2 / 거리^2
+    const std::size_t n = shuffled.size;
+    double logLambda = 0;
+    double squaredSum = 0;
+    out.count = 0;
+    out.tested = 0;
+    while (out.tested < n) {
+        const std::size_t length = std::min(sprtChunk, n - out.tested);
+        std::size_t inliers;
+        if (residuals) {
+            const InlierScore score = scoreKernel(shuffled.x + out.tested, shuffled.y + out.tested,
+                                                  length, out.line.a, out.line.b, limit);
+            inliers = score.count;
+            squaredSum += score.squaredSum;
+        } else {
+            inliers = countKernel(shuffled.x + out.tested, shuffled.y + out.tested, length,
+                                  out.line.a, out.line.b, limit);
+        }
+        out.count += inliers;
+        out.tested += length;
+        if (out.count + (n - out.tested) <= sprt->bestCount) {
+            out.rejected = true;
+            return;
+        }
+        if (sprt->outlierCost > 0 &&
+            squaredSum / distanceScale + (out.tested - out.count) * sprt->outlierCost >= sprt->bestCost) {
+            out.rejected = out.tested < n;
+            if (out.rejected) return;
+        }
+        if (sprt->active) {
+            logLambda += inliers * sprt->logInlier + (length - inliers) * sprt->logOutlier;
+            if (logLambda > sprt->logThreshold) {
+                out.rejected = out.tested < n;
+                if (out.rejected) return;
+            }
+        }
+    }
+    out.cost = scorer.cost(out.count, squaredSum / distanceScale, n);
+}
+
+} // namespace
+
+std::vector<std::size_t> rankByQuality(const double *quality, std::size_t count)
+{
+    std::vector<std::size_t> ranking(count);
+    for (std::size_t i = 0; i < count; i++) {
+        ranking[i] = i;
+    }
+    std::stable_sort(ranking.begin(), ranking.end(), [quality](std::size_t lhs, std::size_t rhs) {
+        return quality[lhs] > quality[rhs];
+    });
+    return ranking;
+}
+
+std::vector<std::size_t> rankByDensity(const PointView &points, int cells)
+{
+    if (points.size == 0) {
+        return {};
+    }
+    if (cells <= 0) {
+        // 칸당 평균 16 점 정도
+        cells = static_cast<int>(std::clamp(std::sqrt(points.size / 16.0), 4.0, 1024.0));
+    }
+
+    double minX = points.x[0], maxX = points.x[0], minY = points.y[0], maxY = points.y[0];
+    for (std::size_t i = 1; i < points.size; i++) {
+        minX = std::min(minX, points.x[i]);
+        maxX = std::max(maxX, points.x[i]);
+        minY = std::min(minY, points.y[i]);
+        maxY = std::max(maxY, points.y[i]);
+    }
+    const double scaleX = maxX > minX ? cells / (maxX - minX) : 0;
+    const double scaleY = maxY > minY ? cells / (maxY - minY) : 0;
+    auto cellOf = [&](std::size_t i) {
+        const int cx = std::min(cells - 1, static_cast<int>((points.x[i] - minX) * scaleX));
+        const int cy = std::min(cells - 1, static_cast<int>((points.y[i] - minY) * scaleY));
+        return static_cast<std::size_t>(cy) * cells + cx;
+    };
+
+    std::vector<std::uint32_t> counts(static_cast<std::size_t>(cells) * cells, 0);
+    for (std::size_t i = 0; i < points.size; i++) {
+        counts[cellOf(i)]++;
+    }
+
+    // 가장 밀도가 높은 칸 하나에 순위가 몰리면 가까운 두 점으로 기울기가 엉망인 가설만
+    // 나온다. 그래서 같은 x 열에서 가장 많은 칸에 대한 비율을 품질로 써서 직선이
+    // 지나는 모든 열이 비슷한 순위가 되게 하고, 같은 품질은 인덱스 해시 순서로 섞는다.
+    std::vector<std::uint32_t> columnMax(cells, 0);
+    for (std::size_t cell = 0; cell < counts.size(); cell++) {
+        std::uint32_t &top = columnMax[cell % cells];
+        top = std::max(top, counts[cell]);
+    }
+
+    struct Ranked {
+        double quality;
+        std::uint64_t order;
+        std::size_t index;
+    };
+    std::vector<Ranked> ranked(points.size);
+    for (std::size_t i = 0; i < points.size; i++) {
+        const std::size_t cell = cellOf(i);
+        SplitMix64 hash{i};
+        ranked[i] = Ranked{static_cast<double>(counts[cell]) / columnMax[cell % cells], hash(), i};
+    }
+    auto better = [](const Ranked &lhs, const Ranked &rhs) {
+        if (lhs.quality != rhs.quality) return lhs.quality > rhs.quality;
+        return lhs.order < rhs.order;
+    };
+    // PROSAC 은 반복마다 집합을 많아야 한 점씩 넓히므로 앞쪽만 정렬해 두면 된다
+    const std::size_t sorted = std::min(points.size, rankDensitySorted);
+    if (sorted < points.size) {
+        std::nth_element(ranked.begin(), ranked.begin() + sorted, ranked.end(), better);
+    }
+    std::sort(ranked.begin(), ranked.begin() + sorted, better);
+
+    std::vector<std::size_t> ranking(points.size);
+    for (std::size_t i = 0; i < points.size; i++) {
+        ranking[i] = ranked[i].index;
+    }
+    return ranking;
+}
+
+RansacResult ransac(const PointView &points, const RansacParams &params, JobControl *control,
+                    Stats *stats)
+{
+    VISION_STAT_TIMER(stats, Stage::Ransac);
+
+    RansacResult best;
+    if (points.size < 2) {
+        return best;
+    }
+
+    unsigned threads = params.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // 가설은 inlier 수 (와 점수) 만 세고, 인덱스와 재추정은 끝나고 최적 가설에 한 번만.
+    // 처음 최적은 inlier 가 하나도 없는 모델의 점수
+    const HypothesisScorer scorer(points, params);
+    LineModel bestHypothesis;
+    std::size_t bestCount = 0;
+    double bestCost = scorer.cost(0, 0, points.size);
+
+    // 적응형 종료면 최적 모델이 나올 때마다 줄어든다
+    const bool adaptive = params.confidence > 0.0;
+    int required = params.iterations;
+
+    // SPRT 는 점을 무작위 순서로 봐야 하므로 (정렬된 CSV 가 흔하다) 섞은 사본을 한 번 만든다
+    PointSet shuffled;
+    SprtState sprt;
+    if (params.sprt) {
+        shuffled.x.assign(points.x, points.x + points.size);
+        shuffled.y.assign(points.y, points.y + points.size);
+        SplitMix64 generator{params.seed ^ 0x5350525453485546ULL};
+        for (std::size_t i = points.size - 1; i > 0; i--) {
+            const std::size_t j = std::uniform_int_distribution<std::size_t>(0, i)(generator);
+            std::swap(shuffled.x[i], shuffled.x[j]);
+            std::swap(shuffled.y[i], shuffled.y[j]);
+        }
+    }
+    const PointView shuffledView = shuffled.view();
+
+    // 스레드가 여럿이면 가설을 블록 단위로 나눠 평가하고, 결과는 가설 번호 순서대로
+    // 반영한다. 동점이면 번호가 작은 가설이 남고, 적응형 종료도 같은 번호에서 멈추므로
+    // 한 스레드로 하나씩 평가한 것과 같은 결과가 된다. 마지막 블록에서 종료 지점
+    // 뒤의 가설은 버리므로, 스레드당 가설 수는 동기화 비용을 덮을 만큼만 (약 25만 점).
+    // SPRT 의 판정 값은 블록 안에서 고정되므로 블록 크기를 스레드 수와 상관없이
+    // 1, 2, 4, ... 로 정해서 결과가 같게 한다.
+    const int perThread = static_cast<int>(
+        std::clamp<std::size_t>((std::size_t(1) << 18) / points.size, 1, 8));
+    int blockSize = threads > 1 ? static_cast<int>(threads) * perThread : 1;
+    if (params.sprt) {
+        blockSize = 1;
+    }
+    std::vector<Hypothesis> block(params.sprt ? sprtMaxBlock : blockSize);
+    ProsacSchedule prosac(points.size);
+    LocalSample loSample;  // LO 작업 버퍼
+
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) {
+        pool.reset(new ThreadPool(threads, threads));
+    }
+
+    // 진행률은 약 100번만 보고
+    int nextReport = 0;
+
+    int next = 0;  // 다음에 반영할 가설 번호
+    while (next < required) {
+        if (isCancelled(control)) break;
+        if (control && next >= nextReport) {
+            control->reportProgress(static_cast<double>(next) / required);
+            nextReport = next + std::max(1, required / 100);
+        }
+
+        const int count = std::min(blockSize, required - next);
+        const std::uint64_t first = static_cast<std::uint64_t>(next);
+        if (params.ranking) {
+            for (int j = 0; j < count; j++) {
+                prosac.next(first + j + 1, block[j].subset, block[j].withNth);
+            }
+        }
+        // 잔차로 점수를 매기면 inlier 수가 적어도 이길 수 있으므로 수 대신 MSAC 비용으로 자른다
+        SprtTest test = sprt.test(scorer.usesResiduals() ? 0 : bestCount);
+        test.bestCost = bestCost;
+        test.outlierCost = scorer.msacOutlierCost();
+        const SprtTest *sprtTest = params.sprt ? &test : nullptr;
+        auto evaluateRange = [&](int begin, int end) {
+            for (int j = begin; j < end; j++) {
+                evaluateHypothesis(points, params, scorer, first + j, shuffledView, sprtTest, block[j]);
+            }
+        };
+        if (pool && count > 1) {
+            const int perTask = (count + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+            for (int begin = 0; begin < count; begin += perTask) {
+                const int end = std::min(count, begin + perTask);
+                pool->submit([&evaluateRange, begin, end] { evaluateRange(begin, end); });
+            }
+            pool->wait();
+        } else {
+            evaluateRange(0, count);
+        }
+
+        // 4. 번호 순서대로 반영: 현재 모델보다 점수가 좋으면 (기본은 인라이어가 더 많으면) 업데이트
+        for (int j = 0; j < count && next < required; j++, next++) {
+            best.iterations++;
+            VISION_STAT_ADD(stats, hypothesesGenerated, 1);
+            const Hypothesis &hypothesis = block[j];
+            if (hypothesis.degenerate) {
+                VISION_STAT_ADD(stats, hypothesesDegenerate, 1);
+                continue;
+            }
+            VISION_STAT_ADD(stats, hypothesesEvaluated, 1);
+            VISION_STAT_ADD(stats, inlierTests, hypothesis.tested);
+
+            if (hypothesis.rejected) {
+                // 버린 가설이 본 inlier 비율로 δ 를 추정하고, 5% 넘게 바뀌면 A 를 다시 구한다
+                VISION_STAT_ADD(stats, hypothesesRejected, 1);
+                sprt.deltaSum += static_cast<double>(hypothesis.count) / hypothesis.tested;
+                sprt.deltaCount++;
+                const double delta = std::max(sprt.deltaSum / sprt.deltaCount, 1e-6);
+                if (std::abs(delta - sprt.delta) > 0.05 * sprt.delta) {
+                    sprt.delta = delta;
+                    sprt.update();
+                }
+                continue;
+            }
+
+            if (hypothesis.cost < bestCost) {
+                bestCount = hypothesis.count;
+                bestCost = hypothesis.cost;
+                bestHypothesis = hypothesis.line;
+                if (params.localOptimization) {
+                    // 샘플링과 겹치지 않는 난수열 (가설 번호의 보수)
+                    SplitMix64 seeder{params.seed + ~static_cast<std::uint64_t>(next) * 0x9E3779B97F4A7C15ULL};
+                    localOptimize(points, scorer, params.threshold, seeder(), bestHypothesis,
+                                  bestCount, bestCost, loSample, stats);
+                }
+                if (params.sprt) {
+                    sprt.epsilon = static_cast<double>(bestCount) / points.size;
+                    sprt.update();
+                }
+
+                if (adaptive) {
+                    // SPRT 는 좋은 가설도 1/A 확률로 버리므로 그만큼 더 뽑는다
+                    const double ratio = static_cast<double>(bestCount) / points.size *
+                                         std::sqrt(sprt.acceptance());
+                    required = std::min(params.iterations,
+                                        requiredIterations(ratio, params.confidence));
+                }
+            }
+        }
+        if (params.sprt) {
+            blockSize = std::min(blockSize * 2, sprtMaxBlock);
+        }
+    }
+
+    // 5. 최적 가설의 inlier 로 재추정
+    if (bestCount > 0) {
+        VISION_STAT_TIMER(stats, Stage::Refit);
+        VISION_STAT_ADD(stats, modelRefits, 1);
+        VISION_STAT_ADD(stats, inlierTests, points.size);
+        best.inliers.reserve(bestCount);
+        collectInliers(points, bestHypothesis, params.threshold, best.inliers);
+        best.model = fitLineLeastSquares(points, best.inliers.data(), best.inliers.size());
+    }
+
+    best.confidence = achievedConfidence(static_cast<double>(best.inliers.size()) / points.size *
+                                             std::sqrt(sprt.acceptance()),
+                                         best.iterations);
+    return best;
+}
+
+} // namespace vision
@@ -0,0 +1,86 @@
+#ifndef VISION_RANSAC_H
+#define VISION_RANSAC_H
+
+#include "inlier_kernel.h"
+#include "job_control.h"
+#include "line_fit.h"
+#include "point_set.h"
+#include "stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vision {
+
+// 가설 점수. 셋 다 inlier 판정과 같은 한 번의 패스 (inlier_kernel) 에서 구한다
+enum class RansacScoring {
+    InlierCount,  // inlier 수 (기본)
+    // MSAC: 거리 제곱을 threshold^2 에서 자른 합 sum min(d^2, threshold^2).
+    // inlier 수가 같아도 더 가까이 지나는 모델이 이겨서 threshold 에 덜 민감하다
+    Msac,
+    // MLESAC: inlier 거리는 정규분포 (threshold = 1.96 sigma), outlier 는 점 범위
+    // (bounding box 대각선) 에 고른 분포로 본 음의 로그우도. 혼합 비율은 EM 대신
+    // 그 가설의 inlier 비율로 정한다 (threshold 로 나눈 hard assignment)
+    Mlesac,
+};
+
+struct RansacParams {
+    int iterations = 1000;     // 반복 횟수 (confidence 를 주면 상한)
+    double threshold = 200.0;  // inlier 판단 거리
+    std::uint64_t seed = 1;    // 같은 seed면 같은 결과
+    // 0 이면 iterations 만큼 고정 반복. (0, 1) 이면 지금까지의 최적 inlier 비율로
+    // 필요한 반복 횟수 N = log(1-p) / log(1-w^2) 를 다시 구하고 N 에 닿으면 멈춘다
+    double confidence = 0.0;
+    // 가설 평가 스레드 수. 0이면 hardware_concurrency. 가설마다 seed 와 가설 번호로
+    // 난수열을 따로 만들고 번호 순서대로 반영하므로 스레드 수와 상관없이 결과가 같다
+    unsigned threads = 1;
+    // 가설마다 모든 점을 세지 않고, 섞은 순서로 세다가 SPRT 로 나쁜 가설이라는
+    // 증거가 충분하거나 최적 모델을 이길 수 없으면 중간에 버린다 (WaldSAC).
+    // 판정 값 ε, δ 는 실행 중에 관찰로 갱신한다
+    bool sprt = false;
+    // PROSAC: 품질이 높은 점부터의 인덱스 (points.size 개의 순열, rankByQuality).
+    // 주면 상위 점들에서 먼저 뽑고 반복이 늘수록 균등 샘플링으로 넓혀 간다.
+    // 적응형 종료는 전체 inlier 비율로 판단한다 (순위가 틀려도 안전하도록)
+    const std::size_t *ranking = nullptr;
+    // LO-RANSAC: 새 최적 가설이 나오면 그 inlier 에서 다시 뽑고 임계값을 줄여 가며
+    // 최소제곱으로 재추정한 모델을 다시 센다. 최적이 바뀔 때만 돌고 내부 작업은 주변 점
+    // 8192 개 표본에서 하므로 추가 비용은 한 번에 가설 두어 개 정도
+    bool localOptimization = false;
+    // 가설을 비교하는 점수. InlierCount 가 아니면 적응형 종료와 SPRT 의 ε 는
+    // 점수가 가장 좋은 가설의 inlier 수로 정한다
+    RansacScoring scoring = RansacScoring::InlierCount;
+};
+
+struct RansacResult {
+    LineModel model;                   // inlier로 재추정한 모델
+    std::vector<std::size_t> inliers;  // 최적 가설의 inlier 인덱스
+    int iterations = 0;                // 실제 수행한 반복 횟수
+    // 최적 inlier 비율 w 로 본, 수행한 반복 안에 전부 inlier 인 샘플을
+    // 적어도 하나 뽑았을 확률 1 - (1 - w^2)^iterations
+    double confidence = 0.0;
+};
+
+// inlier 비율이 inlierRatio 일 때 확률 confidence 로 전부 inlier 인 sampleSize 점
+// 샘플을 적어도 하나 뽑는 데 필요한 반복 횟수. int 범위를 넘으면 INT_MAX
+int requiredIterations(double inlierRatio, double confidence, int sampleSize = 2);
+
+// iterations 번 뽑았을 때 그런 샘플이 적어도 하나 있을 확률
+double achievedConfidence(double inlierRatio, int iterations, int sampleSize = 2);
+
+// quality 가 높은 점부터의 인덱스 (같으면 원래 순서). 센서 신뢰도 열 등
+std::vector<std::size_t> rankByQuality(const double *quality, std::size_t count);
+// 점이 많이 모인 격자 칸 (cells x cells, 0 이면 점 수로 정함) 의 점부터.
+// 직선 위 inlier 는 고르게 흩어진 outlier 보다 밀도가 높다. 앞쪽 65536 개만
+// 정렬하고 나머지는 순서가 없다 (PROSAC 은 그만큼 반복해야 거기까지 넓힌다).
+// 사전 모델까지의 잔차로 순위를 매기면 그 모델 근처 띠가 스스로 합의를 만들어서
+// 쓰지 않는다.
+std::vector<std::size_t> rankByDensity(const PointView &points, int cells = 0);
+
+// 2점 샘플링 RANSAC 직선 추정. 취소되면 그때까지의 최적 모델을 반환한다.
+RansacResult ransac(const PointView &points, const RansacParams &params = RansacParams(),
+                    JobControl *control = nullptr, Stats *stats = nullptr);
+
+} // namespace vision
+
+#endif // VISION_RANSAC_H
@@ -0,0 +1,50 @@
+#include "simd.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace vision {
+
+SimdLevel cpuSimdLevel()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#elif defined(_M_X64)
+    return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel simdLevel()
+{
+    static const SimdLevel level = [] {
+        SimdLevel cpu = cpuSimdLevel();
+        const char *env = std::getenv("VISION_SIMD");
+        if (!env) return cpu;
+
+        SimdLevel requested = cpu;
+        if (std::strcmp(env, "scalar") == 0) requested = SimdLevel::Scalar;
+        else if (std::strcmp(env, "sse2") == 0) requested = SimdLevel::SSE2;
+        else if (std::strcmp(env, "avx2") == 0) requested = SimdLevel::AVX2;
+        else if (std::strcmp(env, "avx512") == 0) requested = SimdLevel::AVX512;
+        return std::min(cpu, requested);
+    }();
+    return level;
+}
+
+const char *simdLevelName(SimdLevel level)
+{
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "";
+}
+
+} // namespace vision
@@ -0,0 +1,25 @@
+#ifndef VISION_SIMD_H
+#define VISION_SIMD_H
+
+namespace vision {
+
+// 런타임에 고르는 SIMD 커널 수준
+enum class SimdLevel {
+    Scalar = 0,
+    SSE2 = 1,
+    AVX2 = 2,
+    AVX512 = 3,
+};
+
+// CPU 가 지원하는 최고 수준
+SimdLevel cpuSimdLevel();
+
+// 실제로 사용할 수준. 환경 변수 VISION_SIMD=scalar|sse2|avx2|avx512 로
+// 낮출 수 있다 (비교 측정용). 처음 호출할 때 한 번만 결정된다.
+SimdLevel simdLevel();
+
+const char *simdLevelName(SimdLevel level);
+
+} // namespace vision
+
+#endif // VISION_SIMD_H
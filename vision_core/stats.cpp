@@ -0,0 +1,98 @@
+#include "stats.h"
+
+#include <sstream>
+
+namespace vision {
+
+const char *stageName(Stage stage)
+{
+    switch (stage) {
+        case Stage::Parse: return "parse";
+        case Stage::Ransac: return "ransac";
+        case Stage::Refit: return "refit";
+        case Stage::LeastSquares: return "least_squares";
+        case Stage::KMeansInit: return "kmeans_init";
+        case Stage::KMeansAssign: return "kmeans_assign";
+        case Stage::KMeansUpdate: return "kmeans_update";
+        case Stage::Scene: return "scene";
+        case Stage::Count: break;
+    }
+    return "";
+}
+
+void Stats::merge(const Stats &other)
+{
+    bytesParsed += other.bytesParsed;
+    rowsParsed += other.rowsParsed;
+    rowsRejected += other.rowsRejected;
+    hypothesesGenerated += other.hypothesesGenerated;
+    hypothesesDegenerate += other.hypothesesDegenerate;
+    hypothesesEvaluated += other.hypothesesEvaluated;
+    hypothesesRejected += other.hypothesesRejected;
+    inlierTests += other.inlierTests;
+    modelRefits += other.modelRefits;
+    kmeansIterations += other.kmeansIterations;
+
+    if (pointsReassigned.size() < other.pointsReassigned.size()) {
+        pointsReassigned.resize(other.pointsReassigned.size(), 0);
+    }
+    for (std::size_t i = 0; i < other.pointsReassigned.size(); i++) {
+        pointsReassigned[i] += other.pointsReassigned[i];
+    }
+
+    for (int i = 0; i < static_cast<int>(Stage::Count); i++) {
+        stageNs[i] += other.stageNs[i];
+    }
+}
+
+std::string Stats::toJson() const
+{
+    std::ostringstream out;
+    out << "{\"bytes_parsed\":" << bytesParsed
+        << ",\"rows_parsed\":" << rowsParsed
+        << ",\"rows_rejected\":" << rowsRejected
+        << ",\"hypotheses_generated\":" << hypothesesGenerated
+        << ",\"hypotheses_degenerate\":" << hypothesesDegenerate
+        << ",\"hypotheses_evaluated\":" << hypothesesEvaluated
+        << ",\"hypotheses_rejected\":" << hypothesesRejected
+        << ",\"inlier_tests\":" << inlierTests
+        << ",\"model_refits\":" << modelRefits
+        << ",\"kmeans_iterations\":" << kmeansIterations
+        << ",\"points_reassigned\":[";
+    for (std::size_t i = 0; i < pointsReassigned.size(); i++) {
+        out << (i ? "," : "") << pointsReassigned[i];
+    }
+    out << "],\"stage_ns\":{";
+    for (int i = 0; i < static_cast<int>(Stage::Count); i++) {
+        out << (i ? "," : "") << '"' << stageName(static_cast<Stage>(i)) << "\":" << stageNs[i];
+    }
+    out << "}}";
+    return out.str();
+}
+
+std::string Stats::summary() const
+{
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(2);
+
+    bool first = true;
+    for (int i = 0; i < static_cast<int>(Stage::Count); i++) {
+        if (stageNs[i] == 0) continue;
+        out << (first ? "" : "  ") << stageName(static_cast<Stage>(i)) << ' '
+            << stageNs[i] / 1e6 << "ms";
+        first = false;
+    }
+    if (rowsParsed) {
+        out << "  rows " << rowsParsed << " (" << rowsRejected << " rejected)";
+    }
+    if (hypothesesGenerated) {
+        out << "  hyp " << hypothesesEvaluated << '/' << hypothesesGenerated;
+    }
+    if (kmeansIterations) {
+        out << "  iter " << kmeansIterations;
+    }
+    return out.str();
+}
+
+} // namespace vision
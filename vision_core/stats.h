@@ -0,0 +1,101 @@
+#ifndef VISION_STATS_H
+#define VISION_STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 0 으로 빌드하면 VISION_STAT_* 매크로가 아무 코드도 만들지 않는다.
+// (CMake 옵션 VISION_CORE_ENABLE_STATS)
+#ifndef VISION_ENABLE_STATS
+#define VISION_ENABLE_STATS 1
+#endif
+
+namespace vision {
+
+// 단계별 누적 시간 구분
+enum class Stage {
+    Parse,
+    Ransac,         // 가설 생성 + 평가 전체 (Refit 포함)
+    Refit,          // 최적 가설 inlier 재추정
+    LeastSquares,
+    KMeansInit,
+    KMeansAssign,
+    KMeansUpdate,
+    Scene,          // 앱에서 그리기 준비
+    Count
+};
+
+const char *stageName(Stage stage);
+
+// 한 작업에서 모은 카운터와 시간. 스레드마다 따로 쓰고 merge 로 합친다.
+// 구조체 모양은 VISION_ENABLE_STATS 와 관계없이 같다.
+struct Stats {
+    std::uint64_t bytesParsed = 0;
+    std::uint64_t rowsParsed = 0;
+    std::uint64_t rowsRejected = 0;
+
+    std::uint64_t hypothesesGenerated = 0;
+    std::uint64_t hypothesesDegenerate = 0;  // 같은 점 / 수직선
+    std::uint64_t hypothesesEvaluated = 0;
+    std::uint64_t hypothesesRejected = 0;    // SPRT 가 중간에 버림 (evaluated 에 포함)
+    std::uint64_t inlierTests = 0;           // 점-직선 거리 비교 횟수
+    std::uint64_t modelRefits = 0;
+
+    std::uint64_t kmeansIterations = 0;
+    std::vector<std::uint64_t> pointsReassigned;  // k-means 반복마다 라벨이 바뀐 점 수
+
+    std::uint64_t stageNs[static_cast<int>(Stage::Count)] = {};
+
+    void merge(const Stats &other);
+    void reset() { *this = Stats(); }
+
+    std::string toJson() const;
+    std::string summary() const;  // 상태 표시줄용 한 줄
+};
+
+// 생성부터 소멸까지의 시간을 stats 의 해당 단계에 더한다.
+class ScopedTimer
+{
+public:
+    ScopedTimer(Stats *stats, Stage stage)
+        : stats(stats), stage(stage)
+    {
+        if (stats) start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer()
+    {
+        if (stats) {
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            stats->stageNs[static_cast<int>(stage)] +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        }
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    Stats *stats;
+    Stage stage;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace vision
+
+#define VISION_STAT_CONCAT_(a, b) a##b
+#define VISION_STAT_CONCAT(a, b) VISION_STAT_CONCAT_(a, b)
+
+#if VISION_ENABLE_STATS
+#define VISION_STAT_ADD(stats, field, n) \
+    do { if (stats) (stats)->field += (n); } while (0)
+#define VISION_STAT_TIMER(stats, stage) \
+    ::vision::ScopedTimer VISION_STAT_CONCAT(visionStatTimer, __LINE__)(stats, stage)
+#else
+#define VISION_STAT_ADD(stats, field, n) do { (void)(stats); } while (0)
+#define VISION_STAT_TIMER(stats, stage) do { (void)(stats); } while (0)
+#endif
+
+#endif // VISION_STATS_H
@@ -0,0 +1,256 @@
+#include "streaming.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace vision {
+
+namespace {
+
+// 청크 하나 읽기 (입력 읽기와 파싱은 Parse 단계로 잡는다)
+bool nextChunk(PointChunkSource &source, PointSet &chunk, Stats *stats)
+{
+    VISION_STAT_TIMER(stats, Stage::Parse);
+    const std::size_t before = source.bytesRead();
+    const bool ok = source.next(chunk);
+    VISION_STAT_ADD(stats, bytesParsed, source.bytesRead() - before);
+    VISION_STAT_ADD(stats, rowsParsed, chunk.size());
+    (void)before;
+    return ok;
+}
+
+// 패스 안에서의 진행률을 [begin, end] 로 보고
+void reportPass(JobControl *control, const PointChunkSource &source, double begin, double end)
+{
+    if (!control || source.totalBytes() == 0) return;
+    const double fraction = static_cast<double>(source.bytesRead()) / source.totalBytes();
+    control->reportProgress(begin + (end - begin) * std::min(fraction, 1.0));
+}
+
+} // namespace
+
+ReservoirSampler::ReservoirSampler(std::size_t capacity, std::uint64_t seed)
+    : capacity(capacity)
+    , gen(seed)
+{
+    reservoir.reserve(capacity);
+}
+
+double ReservoirSampler::uniform()
+{
+    // (0, 1) 구간. log(0) 을 피한다.
+    double u;
+    do {
+        u = std::generate_canonical<double, 53>(gen);
+    } while (u == 0.0);
+    return u;
+}
+
+void ReservoirSampler::scheduleNext()
+{
+    w *= std::exp(std::log(uniform()) / static_cast<double>(capacity));
+    const double skip = std::floor(std::log(uniform()) / std::log1p(-w));
+    // w 가 아주 작으면 skip 이 무한대가 될 수 있다
+    nextIndex += 1 + static_cast<std::uint64_t>(std::min(skip, 1e18));
+}
+
+void ReservoirSampler::add(const PointView &points)
+{
+    if (capacity == 0) {
+        count += points.size;
+        return;
+    }
+
+    std::size_t i = 0;
+
+    // 표본이 찰 때까지는 모두 넣는다
+    while (i < points.size && reservoir.size() < capacity) {
+        reservoir.append(points.x[i], points.y[i]);
+        i++;
+        count++;
+        if (reservoir.size() == capacity) {
+            w = 1.0;
+            nextIndex = count - 1;
+            scheduleNext();
+        }
+    }
+
+    // 이후에는 다음 교체 순번까지 바로 건너뛴다
+    const std::uint64_t end = count + (points.size - i);
+    while (nextIndex < end) {
+        const std::size_t index = i + static_cast<std::size_t>(nextIndex - count);
+        const std::size_t slot = static_cast<std::size_t>(gen() % capacity);
+        reservoir.x[slot] = points.x[index];
+        reservoir.y[slot] = points.y[index];
+        scheduleNext();
+    }
+    count = end;
+}
+
+StreamingLineResult fitLineStreaming(PointChunkSource &source, JobControl *control, Stats *stats)
+{
+    StreamingLineResult result;
+    LineMoments moments;
+    PointSet chunk;
+
+    while (nextChunk(source, chunk, stats)) {
+        if (isCancelled(control)) break;
+        VISION_STAT_TIMER(stats, Stage::LeastSquares);
+        for (std::size_t i = 0; i < chunk.size(); i++) {
+            moments.add(chunk.x[i], chunk.y[i]);
+        }
+        reportPass(control, source, 0.0, 1.0);
+    }
+
+    result.model = moments.solve();
+    result.points = moments.n;
+    result.squaredError = moments.squaredError(result.model);
+    return result;
+}
+
+StreamingRansacResult ransacStreaming(PointChunkSource &source, const RansacParams &params,
+                                      std::size_t sampleSize, JobControl *control, Stats *stats)
+{
+    StreamingRansacResult result;
+    PointSet chunk;
+
+    // 1단계: 표본 (진행률 0 ~ 45%)
+    ReservoirSampler sampler(sampleSize, params.seed);
+    while (nextChunk(source, chunk, stats)) {
+        if (isCancelled(control)) return result;
+        sampler.add(chunk.view());
+        reportPass(control, source, 0.0, 0.45);
+    }
+    result.points = static_cast<std::size_t>(sampler.seen());
+    result.sampleSize = sampler.sample().size();
+
+    // 2단계: 표본에서 RANSAC. 진행률 구간이 겹치지 않게 control 은 넘기지 않는다.
+    const RansacResult sampled = ransac(sampler.sample().view(), params, nullptr, stats);
+    result.iterations = sampled.iterations;
+    result.model = sampled.model;
+    if (isCancelled(control) || sampled.inliers.empty() || !source.rewind()) {
+        return result;
+    }
+    if (control) control->reportProgress(0.55);
+
+    // 3단계: 전체 검증 패스에서 inlier 를 세고 재추정 (55 ~ 100%)
+    // ransac() 와 같은 커널 판정을 써서 경계의 점도 같게 나눈다
+    const LineModel model = sampled.model;
+    LineMoments moments;
+    std::vector<std::size_t> inliers;
+    while (nextChunk(source, chunk, stats)) {
+        if (isCancelled(control)) return result;
+        VISION_STAT_TIMER(stats, Stage::Refit);
+        VISION_STAT_ADD(stats, inlierTests, chunk.size());
+        collectInliers(chunk.view(), model, params.threshold, inliers);
+        for (std::size_t idx : inliers) {
+            moments.add(chunk.x[idx], chunk.y[idx]);
+        }
+        reportPass(control, source, 0.55, 1.0);
+    }
+    VISION_STAT_ADD(stats, modelRefits, 1);
+
+    result.inliers = moments.n;
+    if (moments.n >= 2) {
+        result.model = moments.solve();
+    }
+    return result;
+}
+
+KMeansResult kmeansStreaming(PointChunkSource &source, const KMeansParams &params,
+                             std::size_t sampleSize, JobControl *control, Stats *stats)
+{
+    KMeansResult result;
+    if (params.k <= 0) {
+        return result;
+    }
+
+    // 표본이 전체를 담으면 kmeans() 와 같은 초기 centroid 가 나오도록 같은 seed 로 시작
+    const std::uint64_t seed = params.seed != 0 ? params.seed : std::random_device()();
+    std::mt19937_64 gen(seed);
+    PointSet chunk;
+
+    // 표본으로 k-means++ 초기화
+    ReservoirSampler sampler(sampleSize, seed + 1);
+    while (nextChunk(source, chunk, stats)) {
+        if (isCancelled(control)) return result;
+        sampler.add(chunk.view());
+    }
+    if (sampler.sample().empty()) {
+        return result;
+    }
+    {
+        VISION_STAT_TIMER(stats, Stage::KMeansInit);
+        result.centroids = initializeCentroids(sampler.sample().view(), params.k, gen);
+    }
+
+    // 반복마다 전체를 훑어 클러스터별 합계만 유지한다
+    const int k = static_cast<int>(result.centroids.size());
+    std::vector<int> labels;
+    std::vector<double> sumX(k), sumY(k);
+    std::vector<std::size_t> counts(k);
+
+    while (!result.converged && result.iterations < params.maxIterations) {
+        if (isCancelled(control) || !source.rewind()) break;
+
+        std::fill(sumX.begin(), sumX.end(), 0.0);
+        std::fill(sumY.begin(), sumY.end(), 0.0);
+        std::fill(counts.begin(), counts.end(), 0);
+
+        bool cancelled = false;
+        while (nextChunk(source, chunk, stats)) {
+            if (isCancelled(control)) {
+                cancelled = true;
+                break;
+            }
+            VISION_STAT_TIMER(stats, Stage::KMeansAssign);
+            labels.assign(chunk.size(), -1);
+            assignClusters(chunk.view(), result.centroids, labels.data());
+            for (std::size_t i = 0; i < chunk.size(); i++) {
+                const int c = labels[i];
+                sumX[c] += chunk.x[i];
+                sumY[c] += chunk.y[i];
+                counts[c]++;
+            }
+        }
+        if (cancelled) break;
+
+        // updateCentroids 와 같게 빈 클러스터는 원점
+        std::vector<Centroid> updated(k);
+        {
+            VISION_STAT_TIMER(stats, Stage::KMeansUpdate);
+            for (int c = 0; c < k; c++) {
+                if (counts[c] > 0) {
+                    updated[c].x = sumX[c] / static_cast<double>(counts[c]);
+                    updated[c].y = sumY[c] / static_cast<double>(counts[c]);
+                }
+            }
+        }
+
+        result.converged = hasConverged(result.centroids, updated, params.tolerance);
+        result.centroids = std::move(updated);
+        result.iterations++;
+        VISION_STAT_ADD(stats, kmeansIterations, 1);
+
+        if (control) {
+            control->reportProgress(static_cast<double>(result.iterations) / params.maxIterations);
+        }
+    }
+
+    // 할당 패스의 거리는 갱신 전 centroid 기준이므로, kmeans() 와 같게
+    // 마지막 centroid 로 한 번 더 훑어 wss 를 구한다
+    if (isCancelled(control) || !source.rewind()) {
+        return result;
+    }
+    double wss = 0;
+    while (nextChunk(source, chunk, stats)) {
+        if (isCancelled(control)) return result;
+        VISION_STAT_TIMER(stats, Stage::KMeansAssign);
+        wss += computeWSS(chunk.view(), result.centroids);
+    }
+    result.wss = wss;
+    return result;
+}
+
+} // namespace vision
@@ -0,0 +1,75 @@
+#ifndef VISION_STREAMING_H
+#define VISION_STREAMING_H
+
+#include "job_control.h"
+#include "kmeans.h"
+#include "line_fit.h"
+#include "point_source.h"
+#include "ransac.h"
+#include "stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace vision {
+
+// 메모리보다 큰 입력용 실행 방식. 점은 PointChunkSource 에서 청크 단위로만
+// 들어오고, 작업 메모리는 입력 크기와 관계없이 청크 + 표본 크기로 고정된다.
+
+// 크기를 모르는 스트림에서 균등 표본 (Li 의 Algorithm L, 건너뛸 개수를 한 번에 뽑는다)
+class ReservoirSampler
+{
+public:
+    ReservoirSampler(std::size_t capacity, std::uint64_t seed);
+
+    void add(const PointView &points);
+    const PointSet &sample() const { return reservoir; }
+    std::uint64_t seen() const { return count; }
+
+private:
+    double uniform();
+    void scheduleNext();
+
+    std::size_t capacity;
+    PointSet reservoir;
+    std::mt19937_64 gen;
+    double w = 0;
+    std::uint64_t count = 0;
+    std::uint64_t nextIndex = 0;  // 다음에 표본에 들어갈 점의 순번
+};
+
+struct StreamingLineResult {
+    LineModel model;
+    std::size_t points = 0;
+    double squaredError = 0;  // sumSquaredError 와 같은 값 (중심 모멘트로 계산)
+};
+
+// 청크마다 LineMoments 를 누적하는 한 번의 패스
+StreamingLineResult fitLineStreaming(PointChunkSource &source, JobControl *control = nullptr,
+                                     Stats *stats = nullptr);
+
+struct StreamingRansacResult {
+    LineModel model;
+    std::size_t points = 0;
+    std::size_t sampleSize = 0;
+    std::size_t inliers = 0;  // 전체 점 기준
+    int iterations = 0;
+};
+
+// 1) 저장소 표본에서 RANSAC 으로 모델을 찾고
+// 2) 전체를 다시 훑으며 inlier 를 세고 inlier 로 최소제곱 재추정한다
+StreamingRansacResult ransacStreaming(PointChunkSource &source, const RansacParams &params,
+                                      std::size_t sampleSize = 1 << 20,
+                                      JobControl *control = nullptr, Stats *stats = nullptr);
+
+// 표본으로 k-means++ 초기화 후 반복마다 전체를 한 번씩 훑는 Lloyd.
+// labels 는 채우지 않는다. wss 는 kmeans() 처럼 최종 centroid 기준이며 이를 위해
+// 마지막에 한 번 더 훑는다 (취소되면 0).
+KMeansResult kmeansStreaming(PointChunkSource &source, const KMeansParams &params = KMeansParams(),
+                             std::size_t sampleSize = 1 << 20,
+                             JobControl *control = nullptr, Stats *stats = nullptr);
+
+} // namespace vision
+
+#endif // VISION_STREAMING_H
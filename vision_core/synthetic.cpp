@@ -0,0 +1,101 @@
+#include "synthetic.h"
+
+#include <algorithm>
+
+namespace vision {
+
+LineGenerator::LineGenerator(const LineDatasetParams &params)
+    : params(params)
+    , gen(params.seed)
+    , noise(0.0, params.noise > 0 ? params.noise : 1e-12)
+    , unit(0.0, 1.0)
+{
+    zeroBegin = static_cast<std::uint64_t>(params.rows * params.zeroRunStart);
+    zeroEnd = std::min<std::uint64_t>(
+        params.rows, zeroBegin + static_cast<std::uint64_t>(params.rows * params.zeroRunFraction));
+}
+
+void LineGenerator::next(double &x, double &y)
+{
+    // 원본 데이터처럼 x 는 등간격
+    const double t = params.rows > 1 ? static_cast<double>(row) / (params.rows - 1) : 0.0;
+    x = params.xMin + (params.xMax - params.xMin) * t;
+
+    if (row >= zeroBegin && row < zeroEnd) {
+        y = 0.0;
+    } else if (unit(gen) < params.outlierRatio) {
+        y = params.outlierMin + (params.outlierMax - params.outlierMin) * unit(gen);
+    } else {
+        int line = 0;
+        if (params.lines > 1) {
+            line = std::min(params.lines - 1, static_cast<int>(unit(gen) * params.lines));
+        }
+        const double a = params.slope * (1 + line);
+        const double b = params.intercept - line * params.lineSpacing;
+        y = a * x + b + (params.noise > 0 ? noise(gen) : 0.0);
+    }
+    row++;
+}
+
+BlobGenerator::BlobGenerator(const BlobDatasetParams &params)
+    : params(params)
+    , gen(params.seed)
+    , noise(0.0, params.spread > 0 ? params.spread : 1e-12)
+{
+    // cluster_data_.csv 에서 측정한 세 덩어리 중심
+    static const double measured[3][2] = {{-3.79, 13.49}, {6.81, 4.38}, {9.62, 11.72}};
+
+    std::uniform_real_distribution<double> place(-params.centerRange, params.centerRange);
+    centers.resize(static_cast<std::size_t>(params.blobs) * params.dims);
+    for (int b = 0; b < params.blobs; b++) {
+        for (int d = 0; d < params.dims; d++) {
+            centers[b * params.dims + d] = (b < 3 && d < 2) ? measured[b][d] : place(gen);
+        }
+    }
+}
+
+void BlobGenerator::next(double *coords, int &label)
+{
+    label = static_cast<int>(row % params.blobs);
+    const double *center = &centers[label * params.dims];
+    for (int d = 0; d < params.dims; d++) {
+        coords[d] = center[d] + noise(gen);
+    }
+    row++;
+}
+
+PointSet generateLineDataset(const LineDatasetParams &params)
+{
+    PointSet points;
+    points.reserve(params.rows);
+
+    LineGenerator generator(params);
+    double x, y;
+    while (generator.hasNext()) {
+        generator.next(x, y);
+        points.append(x, y);
+    }
+    return points;
+}
+
+PointSet generateBlobDataset(const BlobDatasetParams &params, std::vector<int> *labels)
+{
+    BlobDatasetParams flat = params;
+    flat.dims = 2;
+
+    PointSet points;
+    points.reserve(flat.rows);
+    if (labels) labels->reserve(flat.rows);
+
+    BlobGenerator generator(flat);
+    double coords[2];
+    int label;
+    while (generator.hasNext()) {
+        generator.next(coords, label);
+        points.append(coords[0], coords[1]);
+        if (labels) labels->push_back(label);
+    }
+    return points;
+}
+
+} // namespace vision
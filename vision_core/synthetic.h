@@ -0,0 +1,84 @@
+#ifndef VISION_SYNTHETIC_H
+#define VISION_SYNTHETIC_H
+
+#include "point_set.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace vision {
+
+// coordinates.csv 와 같은 분포: 잡음 섞인 직선 + 넓게 퍼진 outlier + 0 이 연속된 구간
+struct LineDatasetParams {
+    std::uint64_t rows = 200;
+    int lines = 1;                 // 직선 개수. 행마다 무작위로 하나를 고른다
+    double xMin = 0.0;
+    double xMax = 50.0;
+    double slope = -50.0;          // 첫 번째 직선. j 번째는 slope * (1 + j)
+    double intercept = 500.0;      //                     intercept - j * lineSpacing
+    double lineSpacing = 1000.0;
+    double noise = 200.0;          // y 방향 가우시안 잡음 표준편차
+    double outlierRatio = 0.05;
+    double outlierMin = -2500.0;
+    double outlierMax = 700.0;
+    double zeroRunFraction = 0.15; // 전체 행 중 y = 0 이 연속되는 비율
+    double zeroRunStart = 0.75;    // 0 구간이 시작하는 위치 (행 비율)
+    std::uint64_t seed = 1;
+};
+
+// cluster_data_.csv 와 같은 분포: 라벨이 붙은 가우시안 덩어리
+struct BlobDatasetParams {
+    std::uint64_t rows = 900;
+    int blobs = 3;
+    int dims = 2;
+    double spread = 2.0;        // 덩어리 표준편차
+    double centerRange = 15.0;  // 기본 중심이 없을 때 [-range, range] 에서 무작위
+    std::uint64_t seed = 1;
+};
+
+// 행을 하나씩 만들어 내는 생성기. 전체 데이터를 메모리에 두지 않는다.
+class LineGenerator
+{
+public:
+    explicit LineGenerator(const LineDatasetParams &params);
+
+    bool hasNext() const { return row < params.rows; }
+    void next(double &x, double &y);
+
+private:
+    LineDatasetParams params;
+    std::uint64_t row = 0;
+    std::uint64_t zeroBegin = 0;
+    std::uint64_t zeroEnd = 0;
+    std::mt19937_64 gen;
+    std::normal_distribution<double> noise;
+    std::uniform_real_distribution<double> unit;
+};
+
+class BlobGenerator
+{
+public:
+    explicit BlobGenerator(const BlobDatasetParams &params);
+
+    bool hasNext() const { return row < params.rows; }
+    int dims() const { return params.dims; }
+    // coords 는 dims() 크기
+    void next(double *coords, int &label);
+
+private:
+    BlobDatasetParams params;
+    std::uint64_t row = 0;
+    std::vector<double> centers;  // blobs * dims
+    std::mt19937_64 gen;
+    std::normal_distribution<double> noise;
+};
+
+// 벤치마크처럼 메모리에 바로 올릴 때 사용 (2차원만)
+PointSet generateLineDataset(const LineDatasetParams &params);
+PointSet generateBlobDataset(const BlobDatasetParams &params, std::vector<int> *labels = nullptr);
+
+} // namespace vision
+
+#endif // VISION_SYNTHETIC_H
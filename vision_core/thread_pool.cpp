@@ -0,0 +1,73 @@
+#include "thread_pool.h"
+
+namespace vision {
+
+ThreadPool::ThreadPool(unsigned threads, std::size_t maxQueued)
+{
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+    }
+    this->maxQueued = maxQueued != 0 ? maxQueued : threads * 2;
+
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    spaceAvailable.wait(lock, [this] { return queue.size() < maxQueued; });
+    queue.push_back(std::move(task));
+    lock.unlock();
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] { return queue.empty() && running == 0; });
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;  // stopping 이고 남은 작업 없음
+
+            task = std::move(queue.front());
+            queue.pop_front();
+            running++;
+        }
+        spaceAvailable.notify_one();
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running--;
+            if (queue.empty() && running == 0) {
+                allDone.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace vision
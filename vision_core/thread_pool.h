@@ -0,0 +1,51 @@
+#ifndef VISION_THREAD_POOL_H
+#define VISION_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vision {
+
+// 고정 크기 작업 스레드 풀.
+// 대기 큐 크기가 제한되어 있어서 submit()은 큐가 차면 블록된다.
+// 덕분에 작업마다 파일을 읽어도 동시에 메모리에 올라가는 양이 제한된다.
+class ThreadPool
+{
+public:
+    // threads가 0이면 hardware_concurrency, maxQueued가 0이면 threads * 2
+    explicit ThreadPool(unsigned threads = 0, std::size_t maxQueued = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(std::function<void()> task);
+
+    // 제출한 작업이 모두 끝날 때까지 대기
+    void wait();
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    std::size_t maxQueued;
+    std::size_t running = 0;
+    bool stopping = false;
+
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable spaceAvailable;
+    std::condition_variable allDone;
+};
+
+} // namespace vision
+
+#endif // VISION_THREAD_POOL_H
@@ -0,0 +1,553 @@
+// 여러 CSV 파일을 스레드 풀로 병렬 처리해 결과를 한 파일로 모은다.
+//
+// 사용법:
+//   vision_batch [옵션] <CSV 디렉터리 | 목록 파일>
+//
+//   --algo ransac|lsq|kmeans   실행할 알고리즘 (기본 ransac)
+//   --out <file>               결과 파일 (기본 stdout, - 도 stdout)
+//   --threads <n>              작업 스레드 수 (기본: 코어 수)
+//   --iterations <n>           RANSAC 반복 횟수 (기본 1000)
+//   --threshold <d>            RANSAC inlier 거리 (기본 200)
+//   --confidence <p>           RANSAC 적응형 종료: 확률 p 에 필요한 만큼만 반복
+//                              (--iterations 는 상한)
+//   --sprt                     RANSAC 가설을 SPRT 로 일찍 버림 (점을 섞은 순서로 판정)
+//   --lo                       LO-RANSAC: 새 최적 가설마다 inlier 로 국소 최적화
+//   --score count|msac|mlesac  RANSAC 가설 점수 (기본 count: inlier 수)
+//   --prosac                   RANSAC 샘플링을 밀도가 높은 점부터 (PROSAC).
+//                              --stream 과는 함께 못 씀
+//   --preemptive               RANSAC 을 preemptive 방식으로 (--iterations 개 가설을 만들고
+//                              점 블록마다 약한 가설을 버림). --stream 과는 함께 못 씀
+//   --budget-us <n>            --preemptive 의 시간 제한 (마이크로초, 기본 0: 제한 없음)
+//   --k <n>                    k-means 클러스터 수 (기본 3)
+//   --max-iterations <n>       k-means 최대 반복 (기본 100)
+//   --seed <n>                 난수 seed (기본 1)
+//   --stats <file>             전체 파일의 단계별 통계를 JSON 으로 저장
+//   --no-cache                 CSV 옆의 .vcol 열 캐시를 읽지도 쓰지도 않음
+//   --stream                   메모리보다 큰 입력용: 청크 단위로 읽고 .vpts 도 입력으로 받음
+//   --sample <n>               --stream 의 RANSAC/k-means 표본 크기 (기본 1048576)
+//   --label-column <n>         k-means 정답 라벨 열 (0부터). purity / ARI 를 stderr 로 출력
+//
+// 목록 파일은 한 줄에 경로 하나이며, 상대 경로는 목록 파일 위치 기준이다.
+// gzip / zstd 로 압축된 입력은 별도 스레드에서 압축을 풀면서 파싱한다.
+#include "byte_stream.h"
+#include "cluster_eval.h"
+#include "column_cache.h"
+#include "csv_loader.h"
+#include "kmeans.h"
+#include "line_fit.h"
+#include "preemptive_ransac.h"
+#include "ransac.h"
+#include "stats.h"
+#include "streaming.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+enum class Algorithm { Ransac, LeastSquares, KMeans };
+
+struct BatchOptions {
+    Algorithm algorithm = Algorithm::Ransac;
+    std::string input;
+    std::string output;
+    std::string statsOutput;
+    unsigned threads = 0;
+    unsigned parseThreads = 1;  // 파일 하나 안에서의 파싱 스레드 수
+    bool useCache = true;
+    bool stream = false;
+    std::size_t sampleSize = 1 << 20;  // --stream 에서 RANSAC/k-means 표본 크기
+    int labelColumn = -1;              // k-means 평가용 정답 라벨 열
+    vision::RansacParams ransac;
+    bool prosac = false;              // 밀도 순위로 PROSAC 샘플링
+    bool preemptive = false;          // ransac 대신 preemptiveRansac
+    std::int64_t budgetMicros = 0;    // preemptive 시간 제한
+    vision::KMeansParams kmeans;
+};
+
+void printUsage()
+{
+    std::cerr << "usage: vision_batch [--algo ransac|lsq|kmeans] [--out file] [--threads n]\n"
+                 "                    [--iterations n] [--threshold d] [--confidence p] [--k n]\n"
+                 "                    [--sprt] [--lo] [--score count|msac|mlesac] [--prosac]\n"
+                 "                    [--preemptive] [--budget-us n]\n"
+                 "                    [--max-iterations n] [--seed n] [--stats file] [--no-cache]\n"
+                 "                    [--stream] [--sample n] [--label-column n]\n"
+                 "                    <dir|manifest>\n";
+}
+
+bool parseArguments(int argc, char *argv[], BatchOptions &options)
+{
+    options.kmeans.seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char * {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--algo") {
+            const char *v = value();
+            if (!v) return false;
+            if (std::strcmp(v, "ransac") == 0) options.algorithm = Algorithm::Ransac;
+            else if (std::strcmp(v, "lsq") == 0) options.algorithm = Algorithm::LeastSquares;
+            else if (std::strcmp(v, "kmeans") == 0) options.algorithm = Algorithm::KMeans;
+            else return false;
+        } else if (arg == "--out") {
+            const char *v = value();
+            if (!v) return false;
+            // - 는 stdout (output 이 비어 있으면 stdout)
+            options.output = std::strcmp(v, "-") == 0 ? "" : v;
+        } else if (arg == "--threads") {
+            const char *v = value();
+            if (!v) return false;
+            options.threads = static_cast<unsigned>(std::strtoul(v, nullptr, 10));
+        } else if (arg == "--iterations") {
+            const char *v = value();
+            if (!v) return false;
+            options.ransac.iterations = std::atoi(v);
+        } else if (arg == "--threshold") {
+            const char *v = value();
+            if (!v) return false;
+            options.ransac.threshold = std::atof(v);
+        } else if (arg == "--confidence") {
+            const char *v = value();
+            if (!v) return false;
+            options.ransac.confidence = std::atof(v);
+            if (options.ransac.confidence < 0.0 || options.ransac.confidence >= 1.0) return false;
+        } else if (arg == "--sprt") {
+            options.ransac.sprt = true;
+        } else if (arg == "--lo") {
+            options.ransac.localOptimization = true;
+        } else if (arg == "--score") {
+            const char *v = value();
+            if (!v) return false;
+            if (std::strcmp(v, "count") == 0) options.ransac.scoring = vision::RansacScoring::InlierCount;
+            else if (std::strcmp(v, "msac") == 0) options.ransac.scoring = vision::RansacScoring::Msac;
+            else if (std::strcmp(v, "mlesac") == 0) options.ransac.scoring = vision::RansacScoring::Mlesac;
+            else return false;
+        } else if (arg == "--prosac") {
+            options.prosac = true;
+        } else if (arg == "--preemptive") {
+            options.preemptive = true;
+        } else if (arg == "--budget-us") {
+            const char *v = value();
+            if (!v) return false;
+            options.budgetMicros = std::strtoll(v, nullptr, 10);
+        } else if (arg == "--k") {
+            const char *v = value();
+            if (!v) return false;
+            options.kmeans.k = std::atoi(v);
+        } else if (arg == "--max-iterations") {
+            const char *v = value();
+            if (!v) return false;
+            options.kmeans.maxIterations = std::atoi(v);
+        } else if (arg == "--seed") {
+            const char *v = value();
+            if (!v) return false;
+            options.ransac.seed = std::strtoull(v, nullptr, 10);
+            options.kmeans.seed = options.ransac.seed;
+        } else if (arg == "--stats") {
+            const char *v = value();
+            if (!v) return false;
+            options.statsOutput = v;
+        } else if (arg == "--no-cache") {
+            options.useCache = false;
+        } else if (arg == "--stream") {
+            options.stream = true;
+        } else if (arg == "--sample") {
+            const char *v = value();
+            if (!v) return false;
+            options.sampleSize = static_cast<std::size_t>(std::strtoull(v, nullptr, 10));
+        } else if (arg == "--label-column") {
+            const char *v = value();
+            if (!v) return false;
+            options.labelColumn = std::atoi(v);
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            options.input = arg;
+        }
+    }
+    // 스트리밍은 표본에서 일반 ransac() 만 돌린다
+    return !options.input.empty() && !(options.stream && (options.preemptive || options.prosac));
+}
+
+// 디렉터리면 안의 *.csv (와 .gz / .zst), 아니면 목록 파일로 간주
+bool collectInputs(const std::string &input, bool includePointStreams, std::vector<std::string> &files)
+{
+    std::error_code ec;
+    if (fs::is_directory(input, ec)) {
+        for (const fs::directory_entry &entry : fs::directory_iterator(input, ec)) {
+            // a.csv.gz, a.vpts.zst 처럼 압축된 입력도 받는다
+            const fs::path extension =
+                fs::path(vision::stripCompressionExtension(entry.path().string())).extension();
+            if (entry.is_regular_file() &&
+                (extension == ".csv" || (includePointStreams && extension == ".vpts"))) {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        return !ec;
+    }
+
+    std::ifstream manifest(input);
+    if (!manifest) {
+        return false;
+    }
+
+    const fs::path base = fs::path(input).parent_path();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        fs::path path(line);
+        if (path.is_relative()) path = base / path;
+        files.push_back(path.string());
+    }
+    return true;
+}
+
+const char *algorithmName(Algorithm algorithm)
+{
+    switch (algorithm) {
+        case Algorithm::Ransac: return "ransac";
+        case Algorithm::LeastSquares: return "lsq";
+        case Algorithm::KMeans: return "kmeans";
+    }
+    return "";
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+// 잘못된 행은 결과 표에는 개수만, 줄 번호는 stderr 로
+void reportRejectedRows(const std::string &path, const vision::CsvStats &csvStats)
+{
+    if (csvStats.rejectedLines.empty()) {
+        return;
+    }
+
+    std::ostringstream warning;
+    warning << path << ": " << csvStats.rejectedRows << " rejected rows (line";
+    const std::size_t shown = std::min<std::size_t>(csvStats.rejectedLines.size(), 10);
+    for (std::size_t i = 0; i < shown; i++) {
+        warning << (i == 0 ? " " : ", ") << csvStats.rejectedLines[i];
+    }
+    warning << (csvStats.rejectedRows > shown ? ", ...)\n" : ")\n");
+    std::cerr << warning.str();
+}
+
+// 읽지 못한 파일은 결과 표에 error 만 남기고 이유는 stderr 로
+void reportError(const std::string &path, const std::string &error)
+{
+    std::ostringstream message;
+    message << path << ": " << (error.empty() ? "cannot read input" : error) << '\n';
+    std::cerr << message.str();
+}
+
+vision::CsvOptions csvOptions(const BatchOptions &options)
+{
+    vision::CsvOptions csv;
+    csv.threads = options.parseThreads;
+    if (options.algorithm == Algorithm::KMeans) {
+        csv.maxColumns = -1;  // x, y, label
+        csv.labelColumn = options.labelColumn;
+    }
+    return csv;
+}
+
+// 정답 라벨이 있으면 클러스터링 결과와 비교해서 stderr 로
+void reportAgreement(const std::string &path, const vision::ClusterAgreement &agreement)
+{
+    std::ostringstream message;
+    message << path << ": purity " << agreement.purity << ", ARI " << agreement.adjustedRandIndex
+            << " (" << agreement.truthClusters << " labels, " << agreement.predictedClusters
+            << " clusters)\n";
+    std::cerr << message.str();
+}
+
+// --stream: 파일 전체를 올리지 않고 청크 단위로 처리. 메모리는 청크 + 표본 크기.
+std::string processFileStreaming(const std::string &path, const BatchOptions &options,
+                                 vision::Stats &stats)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::ostringstream row;
+    row.precision(10);
+    row << path << '\t' << algorithmName(options.algorithm) << '\t';
+
+    const Clock::time_point start = Clock::now();
+    std::string error;
+    std::unique_ptr<vision::PointChunkSource> source =
+        vision::openPointSource(path, csvOptions(options), &error);
+    if (!source) {
+        reportError(path, error);
+        row << "error\t0\t0\t\t\t\t\t\t0\t0\n";
+        return row.str();
+    }
+
+    double a = 0, b = 0, wss = 0;
+    std::size_t inliers = 0;
+    int iterations = 0;
+
+    switch (options.algorithm) {
+        case Algorithm::Ransac: {
+            const vision::StreamingRansacResult result =
+                vision::ransacStreaming(*source, options.ransac, options.sampleSize, nullptr, &stats);
+            a = result.model.a;
+            b = result.model.b;
+            inliers = result.inliers;
+            iterations = result.iterations;
+            break;
+        }
+        case Algorithm::LeastSquares: {
+            const vision::StreamingLineResult result = vision::fitLineStreaming(*source, nullptr, &stats);
+            a = result.model.a;
+            b = result.model.b;
+            wss = result.squaredError;
+            inliers = result.points;
+            break;
+        }
+        case Algorithm::KMeans: {
+            const vision::KMeansResult result =
+                vision::kmeansStreaming(*source, options.kmeans, options.sampleSize, nullptr, &stats);
+            wss = result.wss;
+            iterations = result.iterations;
+            break;
+        }
+    }
+    const double totalMs = elapsedMs(start);
+
+    if (!source->error().empty()) {
+        reportError(path, source->error());
+        row << "error\t0\t0\t\t\t\t\t\t0\t" << totalMs << "\n";
+        return row.str();
+    }
+
+    // CSV 면 마지막 패스의 행 통계, .vpts 는 모든 행이 유효
+    vision::CsvStats csvStats;
+    if (const vision::CsvChunkSource *csvSource = dynamic_cast<const vision::CsvChunkSource *>(source.get())) {
+        csvStats = csvSource->csvStats();
+    } else {
+        csvStats.rows = source->pointsRead();
+    }
+    reportRejectedRows(path, csvStats);
+
+    // 읽기와 계산이 섞여 있으므로 parse_ms 는 단계 타이머 값 (통계를 끄면 0)
+    const double parseMs = stats.stageNs[static_cast<std::size_t>(vision::Stage::Parse)] / 1e6;
+    row << "ok\t" << csvStats.rows << '\t' << csvStats.rejectedRows << '\t';
+    if (options.algorithm == Algorithm::KMeans) {
+        row << "\t\t";
+    } else {
+        row << a << '\t' << b << '\t';
+    }
+    row << inliers << '\t' << wss << '\t' << iterations << '\t' << parseMs << '\t'
+        << totalMs - parseMs << '\n';
+    return row.str();
+}
+
+// 파일 하나 처리 후 결과 한 줄(TSV) 반환
+std::string processFile(const std::string &path, const BatchOptions &options, vision::Stats &stats)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const vision::CsvOptions csv = csvOptions(options);
+
+    const Clock::time_point parseStart = Clock::now();
+    // 캐시가 유효하면 매핑만, 아니면 파싱 후 캐시 생성
+    vision::ColumnCache cache;
+    vision::PointSet parsed;
+    vision::CsvStats csvStats;
+    std::string error;
+    bool loaded;
+    if (options.useCache) {
+        loaded = vision::loadCsvCached(path, csv, cache, &error, &stats);
+        if (loaded) csvStats = cache.csvStats();
+    } else {
+        loaded = vision::loadCsvFile(path, csv, parsed, &csvStats, &error, &stats);
+    }
+    const vision::PointView points = options.useCache ? cache.view() : parsed.view();
+    const double parseMs = elapsedMs(parseStart);
+
+    if (loaded) {
+        reportRejectedRows(path, csvStats);
+    }
+
+    std::ostringstream row;
+    row.precision(10);
+    row << path << '\t' << algorithmName(options.algorithm) << '\t';
+    if (!loaded) {
+        reportError(path, error);
+        row << "error\t0\t0\t\t\t\t\t\t" << parseMs << "\t0\n";
+        return row.str();
+    }
+
+    const Clock::time_point fitStart = Clock::now();
+    double a = 0, b = 0, wss = 0;
+    std::size_t inliers = 0;
+    int iterations = 0;
+
+    switch (options.algorithm) {
+        case Algorithm::Ransac: {
+            if (options.preemptive) {
+                vision::PreemptiveRansacParams params;
+                params.hypotheses = options.ransac.iterations;
+                params.threshold = options.ransac.threshold;
+                params.seed = options.ransac.seed;
+                params.budgetMicros = options.budgetMicros;
+                const vision::PreemptiveRansacResult result = vision::preemptiveRansac(points, params, &stats);
+                a = result.model.a;
+                b = result.model.b;
+                inliers = result.inliers.size();
+                iterations = result.hypotheses;
+                break;
+            }
+            vision::RansacParams params = options.ransac;
+            std::vector<std::size_t> ranking;
+            if (options.prosac) {
+                ranking = vision::rankByDensity(points);
+                params.ranking = ranking.data();
+            }
+            const vision::RansacResult result = vision::ransac(points, params, nullptr, &stats);
+            a = result.model.a;
+            b = result.model.b;
+            inliers = result.inliers.size();
+            iterations = result.iterations;
+            break;
+        }
+        case Algorithm::LeastSquares: {
+            VISION_STAT_TIMER(&stats, vision::Stage::LeastSquares);
+            const vision::LineModel model = vision::fitLineLeastSquares(points);
+            a = model.a;
+            b = model.b;
+            wss = vision::sumSquaredError(points, model);
+            inliers = points.size;
+            break;
+        }
+        case Algorithm::KMeans: {
+            const vision::KMeansResult result = vision::kmeans(points, options.kmeans, nullptr, &stats);
+            wss = result.wss;
+            iterations = result.iterations;
+
+            const int *labels = options.useCache ? cache.labels()
+                                                 : (parsed.hasLabels() ? parsed.labels.data() : nullptr);
+            if (labels && result.labels.size() == points.size) {
+                reportAgreement(path, vision::compareClusterings(labels, result.labels.data(), points.size));
+            }
+            break;
+        }
+    }
+    const double fitMs = elapsedMs(fitStart);
+
+    row << "ok\t" << csvStats.rows << '\t' << csvStats.rejectedRows << '\t';
+    if (options.algorithm == Algorithm::KMeans) {
+        row << "\t\t";
+    } else {
+        row << a << '\t' << b << '\t';
+    }
+    row << inliers << '\t' << wss << '\t' << iterations << '\t' << parseMs << '\t' << fitMs << '\n';
+    return row.str();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BatchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    std::vector<std::string> files;
+    if (!collectInputs(options.input, options.stream, files)) {
+        std::cerr << "Cannot read input: " << options.input << '\n';
+        return 1;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // 파일이 하나뿐이면 파일 단위 병렬화 대신 파일 안을 나눠서 파싱하고
+    // RANSAC 가설도 나눠서 평가
+    if (files.size() == 1) {
+        options.parseThreads = options.threads;
+        options.ransac.threads = options.threads;
+    }
+
+    // 결과는 입력 순서대로 기록하기 위해 파일 인덱스 위치에 저장
+    std::vector<std::string> rows(files.size());
+    unsigned threads = 0;
+    vision::Stats totalStats;
+    std::mutex statsMutex;
+    {
+        vision::ThreadPool pool(options.threads);
+        threads = pool.size();
+        for (std::size_t i = 0; i < files.size(); i++) {
+            pool.submit([&, i] {
+                vision::Stats stats;
+                rows[i] = options.stream ? processFileStreaming(files[i], options, stats)
+                                         : processFile(files[i], options, stats);
+
+                std::lock_guard<std::mutex> lock(statsMutex);
+                totalStats.merge(stats);
+            });
+        }
+        pool.wait();
+    }
+
+    const double totalMs = elapsedMs(start);
+
+    std::ofstream outFile;
+    if (!options.output.empty()) {
+        outFile.open(options.output, std::ios::binary);
+        if (!outFile) {
+            std::cerr << "Cannot open output: " << options.output << '\n';
+            return 1;
+        }
+    }
+    std::ostream &out = options.output.empty() ? std::cout : outFile;
+
+    out << "file\talgo\tstatus\trows\trejected\ta\tb\tinliers\twss\titerations\tparse_ms\tfit_ms\n";
+    for (const std::string &row : rows) {
+        out << row;
+    }
+
+    std::size_t failed = 0;
+    for (const std::string &row : rows) {
+        if (row.find("\terror\t") != std::string::npos) failed++;
+    }
+
+    if (!options.statsOutput.empty()) {
+        std::ofstream statsFile(options.statsOutput, std::ios::binary);
+        statsFile << totalStats.toJson() << '\n';
+        if (!statsFile) {
+            std::cerr << "Cannot write stats: " << options.statsOutput << '\n';
+        }
+    }
+
+    std::fprintf(stderr, "%zu files (%zu failed), %u threads, %.1f ms, %.1f files/s\n",
+                 files.size(), failed, threads, totalMs,
+                 totalMs > 0 ? files.size() * 1000.0 / totalMs : 0.0);
+    return failed == 0 ? 0 : 1;
+}
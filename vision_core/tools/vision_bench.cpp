@@ -0,0 +1,280 @@
+// RANSAC / 최소제곱법 / k-means 성능 측정.
+//
+// 사용법:
+//   vision_bench [옵션]
+//
+//   --algos <list>        ransac,lsq,kmeans 중 쉼표로 구분 (기본 전부)
+//   --min-points <n>      가장 작은 데이터 크기 (기본 1000)
+//   --max-points <n>      가장 큰 데이터 크기, 10배씩 증가 (기본 1000000, 최대 1e8)
+//   --threads <n>         1, 2, 4, ... n 스레드까지 측정 (기본: 코어 수)
+//   --repeat <n>          같은 조건 반복 후 최솟값 사용 (기본 3)
+//   --iterations <n>      RANSAC 반복 횟수 (기본 100)
+//   --confidence <p>      RANSAC 적응형 종료 확률 (기본 0: 고정 반복)
+//   --k <n>               k-means 클러스터 수 (기본 3)
+//   --seed <n>            데이터/알고리즘 seed (기본 1)
+//   --out <file>          결과 파일 (기본 stdout)
+//
+// 결과는 한 줄에 JSON 객체 하나 (JSON Lines) 이므로 릴리스 간 diff 하기 쉽다.
+// 멀티 스레드 측정은 같은 데이터에 대해 스레드마다 독립된 실행을 동시에 돌린
+// 전체 처리량이다. ransac_mt 는 한 번의 RANSAC 을 n 스레드로 나눠 돌린 시간이고
+// speedup 은 1 스레드 대비 배수다 (모델은 스레드 수와 상관없이 같다).
+#include "kmeans.h"
+#include "line_fit.h"
+#include "point_set.h"
+#include "ransac.h"
+#include "synthetic.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct BenchOptions {
+    bool ransac = true;
+    bool leastSquares = true;
+    bool kmeans = true;
+    double minPoints = 1e3;
+    double maxPoints = 1e6;
+    unsigned maxThreads = 0;
+    int repeat = 3;
+    int iterations = 100;
+    double confidence = 0.0;
+    int k = 3;
+    std::uint64_t seed = 1;
+    std::string output;
+};
+
+void printUsage()
+{
+    std::cerr << "usage: vision_bench [--algos ransac,lsq,kmeans] [--min-points n] [--max-points n]\n"
+                 "                    [--threads n] [--repeat n] [--iterations n] [--k n]\n"
+                 "                    [--confidence p] [--seed n] [--out file]\n";
+}
+
+bool parseArguments(int argc, char *argv[], BenchOptions &options)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+
+        if (arg == "--algos") {
+            options.ransac = value.find("ransac") != std::string::npos;
+            options.leastSquares = value.find("lsq") != std::string::npos;
+            options.kmeans = value.find("kmeans") != std::string::npos;
+        } else if (arg == "--min-points") {
+            options.minPoints = std::atof(value.c_str());
+        } else if (arg == "--max-points") {
+            options.maxPoints = std::min(std::atof(value.c_str()), 1e8);
+        } else if (arg == "--threads") {
+            options.maxThreads = static_cast<unsigned>(std::atoi(value.c_str()));
+        } else if (arg == "--repeat") {
+            options.repeat = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--iterations") {
+            options.iterations = std::atoi(value.c_str());
+        } else if (arg == "--confidence") {
+            options.confidence = std::atof(value.c_str());
+        } else if (arg == "--k") {
+            options.k = std::atoi(value.c_str());
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--out") {
+            options.output = value;
+        } else {
+            return false;
+        }
+    }
+    return options.minPoints >= 1 && options.minPoints <= options.maxPoints;
+}
+
+long peakRssKb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;  // Linux 에서는 KB 단위
+}
+
+struct RunResult {
+    double seconds = 0;
+    int iterations = 0;
+};
+
+// 스레드 수만큼 같은 작업을 동시에 실행하고 전체 경과 시간 측정
+template <typename Fn>
+RunResult runConcurrent(unsigned threads, Fn fn)
+{
+    std::vector<int> iterations(threads, 0);
+    const auto start = std::chrono::steady_clock::now();
+    if (threads == 1) {
+        iterations[0] = fn(0);
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] { iterations[t] = fn(t); });
+        }
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    RunResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.iterations = iterations[0];
+    return result;
+}
+
+void report(std::ostream &out, const char *algo, std::size_t points, unsigned threads,
+            const RunResult &run, double baseSeconds = 0)
+{
+    // 스레드마다 points 개씩 처리했으면 전체 처리량은 threads 배.
+    // baseSeconds 가 있으면 한 실행을 나눈 측정이라 points 그대로
+    const double totalPoints = static_cast<double>(points) * (baseSeconds > 0 ? 1 : threads);
+
+    std::ostringstream line;
+    line.precision(6);
+    line << "{\"algo\":\"" << algo << "\",\"points\":" << points
+         << ",\"threads\":" << threads
+         << ",\"iterations\":" << run.iterations
+         << ",\"seconds\":" << run.seconds
+         << ",\"ns_per_point\":" << run.seconds * 1e9 / points
+         << ",\"points_per_sec\":" << (run.seconds > 0 ? totalPoints / run.seconds : 0.0)
+         << (baseSeconds > 0 ? ",\"speedup\":" + std::to_string(baseSeconds / run.seconds) : "")
+         << ",\"peak_rss_kb\":" << peakRssKb() << "}\n";
+    out << line.str();
+    out.flush();
+}
+
+// 측정할 스레드 수: 1, 2, 4, ... 와 2의 거듭제곱이 아닌 최대 스레드 수
+std::vector<unsigned> threadCounts(unsigned maxThreads)
+{
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    if (counts.empty() || counts.back() != maxThreads) {
+        counts.push_back(maxThreads);
+    }
+    return counts;
+}
+
+template <typename Fn>
+void measure(std::ostream &out, const BenchOptions &options, const char *algo,
+             std::size_t points, Fn fn)
+{
+    for (unsigned threads : threadCounts(options.maxThreads)) {
+        RunResult best;
+        for (int r = 0; r < options.repeat; r++) {
+            const RunResult run = runConcurrent(threads, fn);
+            if (r == 0 || run.seconds < best.seconds) best = run;
+        }
+        report(out, algo, points, threads, best);
+    }
+}
+
+// 한 번의 실행을 1, 2, 4, ... 스레드로 나눠 돌린 시간과 1 스레드 대비 배수
+template <typename Fn>
+void measureSplit(std::ostream &out, const BenchOptions &options, const char *algo,
+                  std::size_t points, Fn fn)
+{
+    double baseSeconds = 0;
+    for (unsigned threads : threadCounts(options.maxThreads)) {
+        RunResult best;
+        for (int r = 0; r < options.repeat; r++) {
+            RunResult run;
+            const auto start = std::chrono::steady_clock::now();
+            run.iterations = fn(threads);
+            run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (r == 0 || run.seconds < best.seconds) best = run;
+        }
+        if (threads == 1) baseSeconds = best.seconds;
+        report(out, algo, points, threads, best, baseSeconds);
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+    if (options.maxThreads == 0) {
+        options.maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::ofstream outFile;
+    if (!options.output.empty()) {
+        outFile.open(options.output, std::ios::binary);
+        if (!outFile) {
+            std::cerr << "Cannot open output: " << options.output << '\n';
+            return 1;
+        }
+    }
+    std::ostream &out = options.output.empty() ? std::cout : outFile;
+
+    for (double size = options.minPoints; size <= options.maxPoints * 1.0001; size *= 10) {
+        const std::size_t n = static_cast<std::size_t>(size);
+
+        if (options.ransac || options.leastSquares) {
+            vision::LineDatasetParams dataset;
+            dataset.rows = n;
+            dataset.seed = options.seed;
+            const vision::PointSet data = vision::generateLineDataset(dataset);
+            const vision::PointView view = data.view();
+
+            if (options.ransac) {
+                vision::RansacParams params;
+                params.iterations = options.iterations;
+                params.confidence = options.confidence;
+                params.seed = options.seed;
+                measure(out, options, "ransac", n, [&](unsigned) {
+                    return vision::ransac(view, params).iterations;
+                });
+                measureSplit(out, options, "ransac_mt", n, [&](unsigned threads) {
+                    vision::RansacParams split = params;
+                    split.threads = threads;
+                    return vision::ransac(view, split).iterations;
+                });
+            }
+            if (options.leastSquares) {
+                measure(out, options, "lsq", n, [&](unsigned) {
+                    volatile double a = vision::fitLineLeastSquares(view).a;
+                    (void)a;
+                    return 1;
+                });
+            }
+        }
+
+        if (options.kmeans) {
+            vision::BlobDatasetParams dataset;
+            dataset.rows = n;
+            dataset.seed = options.seed;
+            const vision::PointSet data = vision::generateBlobDataset(dataset);
+            const vision::PointView view = data.view();
+
+            vision::KMeansParams params;
+            params.k = options.k;
+            params.seed = options.seed;
+            measure(out, options, "kmeans", n, [&](unsigned) {
+                return vision::kmeans(view, params).iterations;
+            });
+        }
+    }
+
+    return 0;
+}
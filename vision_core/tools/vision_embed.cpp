@@ -0,0 +1,186 @@
+// CSV 를 빌드할 때 미리 파싱해서 정적 배열을 정의하는 C++ 소스로 바꾼다.
+// CMake 의 vision_embed_csv() 가 앱 빌드 중에 호출한다.
+//
+// 사용법:
+//   vision_embed [옵션] <CSV> <이름> <출력 .cpp> <출력 .h>
+//
+//   --no-header          첫 줄도 데이터로 읽음
+//   --max-columns <n>    열이 이보다 많은 행은 건너뜀 (-1이면 제한 없음, 기본 2)
+//   --label-column <n>   정답 라벨 열 (0부터)
+//
+// 파싱은 실행 시간과 같은 parseCsv 로 하고 값은 %.17g 로 써서 비트 단위로 같다.
+// 결과는 vision::embedded::<이름> (vision::EmbeddedDataset).
+#include "csv_loader.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct EmbedOptions {
+    vision::CsvOptions csv;
+    std::string input;
+    std::string name;
+    std::string sourceOutput;
+    std::string headerOutput;
+};
+
+void printUsage()
+{
+    std::cerr << "usage: vision_embed [--no-header] [--max-columns n] [--label-column n]\n"
+                 "                    <csv> <name> <out.cpp> <out.h>\n";
+}
+
+bool parseArguments(int argc, char *argv[], EmbedOptions &options)
+{
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char * {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--no-header") {
+            options.csv.skipHeader = false;
+        } else if (arg == "--max-columns") {
+            const char *v = value();
+            if (!v) return false;
+            options.csv.maxColumns = std::atoi(v);
+        } else if (arg == "--label-column") {
+            const char *v = value();
+            if (!v) return false;
+            options.csv.labelColumn = std::atoi(v);
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() != 4) {
+        return false;
+    }
+    options.input = positional[0];
+    options.name = positional[1];
+    options.sourceOutput = positional[2];
+    options.headerOutput = positional[3];
+    return true;
+}
+
+// 한 줄에 8개씩
+template <typename T, typename Write>
+void writeArray(std::FILE *out, const char *type, const std::string &name, const std::vector<T> &values,
+                Write write)
+{
+    std::fprintf(out, "alignas(64) const %s %s[] = {", type, name.c_str());
+    if (values.empty()) {
+        std::fprintf(out, "0");  // 크기 0 배열은 만들 수 없다
+    }
+    for (std::size_t i = 0; i < values.size(); i++) {
+        std::fprintf(out, i % 8 == 0 ? "\n    " : " ");
+        write(out, values[i]);
+        std::fprintf(out, ",");
+    }
+    std::fprintf(out, "\n};\n\n");
+}
+
+bool writeSource(const EmbedOptions &options, const vision::PointSet &points,
+                 const vision::CsvStats &csvStats, const std::string &headerName)
+{
+    std::FILE *out = std::fopen(options.sourceOutput.c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+
+    const std::string sourceName = std::filesystem::path(options.input).filename().string();
+    std::fprintf(out, "// vision_embed 가 %s 에서 만든 파일. 직접 고치지 말 것.\n", sourceName.c_str());
+    std::fprintf(out, "#include \"%s\"\n\n#include <limits>\n\nnamespace {\n\n", headerName.c_str());
+
+    // parseCsv 는 inf / nan 도 받으므로 리터럴로 쓸 수 없는 값은 numeric_limits 로
+    auto writeDouble = [](std::FILE *file, double v) {
+        if (std::isnan(v)) {
+            std::fprintf(file, "std::numeric_limits<double>::quiet_NaN()");
+        } else if (std::isinf(v)) {
+            std::fprintf(file, "%sstd::numeric_limits<double>::infinity()", v < 0 ? "-" : "");
+        } else {
+            std::fprintf(file, "%.17g", v);
+        }
+    };
+    writeArray(out, "double", "x", points.x, writeDouble);
+    writeArray(out, "double", "y", points.y, writeDouble);
+    if (points.hasLabels()) {
+        writeArray(out, "int", "labels", points.labels, [](std::FILE *file, int v) { std::fprintf(file, "%d", v); });
+    }
+    const std::vector<std::size_t> &lines = csvStats.rejectedLines;
+    writeArray(out, "std::size_t", "rejectedLines", lines,
+               [](std::FILE *file, std::size_t v) { std::fprintf(file, "%zu", v); });
+
+    std::fprintf(out, "} // namespace\n\nnamespace vision {\nnamespace embedded {\n\n");
+    std::fprintf(out, "const EmbeddedDataset %s = {\n", options.name.c_str());
+    std::fprintf(out, "    \"%s\",\n", sourceName.c_str());
+    std::fprintf(out, "    x,\n    y,\n    %s,\n", points.hasLabels() ? "labels" : "nullptr");
+    std::fprintf(out, "    %zu,\n    %zu,\n    %zu,\n", points.size(), csvStats.rows, csvStats.rejectedRows);
+    std::fprintf(out, "    rejectedLines,\n    %zu,\n};\n\n", lines.size());
+    std::fprintf(out, "} // namespace embedded\n} // namespace vision\n");
+
+    return std::fclose(out) == 0;
+}
+
+bool writeHeader(const EmbedOptions &options)
+{
+    std::FILE *out = std::fopen(options.headerOutput.c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+
+    std::string guard = "VISION_EMBEDDED_" + options.name + "_H";
+    for (char &c : guard) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    std::fprintf(out, "// vision_embed 가 만든 파일. 직접 고치지 말 것.\n");
+    std::fprintf(out, "#ifndef %s\n#define %s\n\n", guard.c_str(), guard.c_str());
+    std::fprintf(out, "#include \"embedded_dataset.h\"\n\n");
+    std::fprintf(out, "namespace vision {\nnamespace embedded {\n\n");
+    std::fprintf(out, "extern const EmbeddedDataset %s;\n\n", options.name.c_str());
+    std::fprintf(out, "} // namespace embedded\n} // namespace vision\n\n#endif // %s\n", guard.c_str());
+
+    return std::fclose(out) == 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    EmbedOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+    if (options.csv.labelColumn >= 0 && options.csv.maxColumns >= 0 &&
+        options.csv.maxColumns <= options.csv.labelColumn) {
+        std::cerr << "--label-column needs --max-columns greater than it (or -1)\n";
+        return 2;
+    }
+
+    vision::PointSet points;
+    vision::CsvStats csvStats;
+    std::string error;
+    if (!vision::loadCsvFile(options.input, options.csv, points, &csvStats, &error)) {
+        std::cerr << error << '\n';
+        return 1;
+    }
+
+    const std::string headerName = std::filesystem::path(options.headerOutput).filename().string();
+    if (!writeHeader(options) || !writeSource(options, points, csvStats, headerName)) {
+        std::cerr << "Cannot write " << options.sourceOutput << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,255 @@
+// coordinates.csv / cluster_data_.csv 와 같은 분포의 합성 데이터를 만든다.
+// 행 단위로 생성해 바로 쓰기 때문에 수 GB 파일도 고정된 메모리로 만들 수 있다.
+//
+// 사용법:
+//   vision_gen line  [--rows n] [--lines n] [--noise d] [--outliers r]
+//                    [--zero-run f] [--slope a] [--intercept b]
+//   vision_gen blobs [--rows n] [--blobs n] [--dims d] [--spread s]
+//
+//   공통: --out <file>  (기본 stdout)
+//         --format csv|bin  (기본: 확장자가 .vpts 면 bin, 아니면 csv)
+//         --seed <n>
+#include "point_stream.h"
+#include "synthetic.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct GenOptions {
+    bool blobs = false;
+    std::string output = "-";
+    std::string format;
+    vision::LineDatasetParams line;
+    vision::BlobDatasetParams blob;
+};
+
+void printUsage()
+{
+    std::cerr << "usage: vision_gen line  [--rows n] [--lines n] [--noise d] [--outliers r]\n"
+                 "                        [--zero-run f] [--slope a] [--intercept b]\n"
+                 "       vision_gen blobs [--rows n] [--blobs n] [--dims d] [--spread s]\n"
+                 "       common: [--out file] [--format csv|bin] [--seed n]\n";
+}
+
+bool parseArguments(int argc, char *argv[], GenOptions &options)
+{
+    if (argc < 2) return false;
+
+    const std::string kind = argv[1];
+    if (kind == "blobs") options.blobs = true;
+    else if (kind != "line") return false;
+
+    for (int i = 2; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        const char *value = argv[++i];
+
+        if (arg == "--rows") {
+            options.line.rows = options.blob.rows = static_cast<std::uint64_t>(std::atof(value));
+        } else if (arg == "--out") {
+            options.output = value;
+        } else if (arg == "--format") {
+            options.format = value;
+        } else if (arg == "--seed") {
+            options.line.seed = options.blob.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--lines") {
+            options.line.lines = std::max(1, std::atoi(value));
+        } else if (arg == "--noise") {
+            options.line.noise = std::atof(value);
+        } else if (arg == "--outliers") {
+            options.line.outlierRatio = std::atof(value);
+        } else if (arg == "--zero-run") {
+            options.line.zeroRunFraction = std::atof(value);
+        } else if (arg == "--slope") {
+            options.line.slope = std::atof(value);
+        } else if (arg == "--intercept") {
+            options.line.intercept = std::atof(value);
+        } else if (arg == "--blobs") {
+            options.blob.blobs = std::max(1, std::atoi(value));
+        } else if (arg == "--dims") {
+            options.blob.dims = std::max(1, std::atoi(value));
+        } else if (arg == "--spread") {
+            options.blob.spread = std::atof(value);
+        } else {
+            return false;
+        }
+    }
+
+    if (options.format.empty()) {
+        const std::string &out = options.output;
+        const bool vpts = out.size() > 5 && out.compare(out.size() - 5, 5, ".vpts") == 0;
+        options.format = vpts ? "bin" : "csv";
+    }
+    return options.format == "csv" || options.format == "bin";
+}
+
+// to_chars 로 숫자를 버퍼에 바로 쓰는 CSV 출력
+class CsvWriter
+{
+public:
+    explicit CsvWriter(std::FILE *file) : file(file) { buffer.reserve(capacity + 512); }
+    ~CsvWriter() { flush(); }
+
+    void text(const char *s)
+    {
+        while (*s) buffer.push_back(*s++);
+    }
+
+    void number(double value)
+    {
+        char tmp[32];
+        const std::to_chars_result r = std::to_chars(tmp, tmp + sizeof(tmp), value);
+        buffer.insert(buffer.end(), tmp, r.ptr);
+    }
+
+    void number(int value)
+    {
+        char tmp[16];
+        const std::to_chars_result r = std::to_chars(tmp, tmp + sizeof(tmp), value);
+        buffer.insert(buffer.end(), tmp, r.ptr);
+    }
+
+    void put(char c) { buffer.push_back(c); }
+
+    void endRow()
+    {
+        buffer.push_back('\n');
+        if (buffer.size() >= capacity) flush();
+    }
+
+    bool flush()
+    {
+        if (!buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+            failed = true;
+        }
+        buffer.clear();
+        return !failed;
+    }
+
+    bool ok() const { return !failed; }
+
+private:
+    static const std::size_t capacity = 1 << 20;
+    std::FILE *file;
+    std::vector<char> buffer;
+    bool failed = false;
+};
+
+bool writeCsv(const GenOptions &options, std::FILE *file)
+{
+    CsvWriter out(file);
+
+    if (!options.blobs) {
+        vision::LineGenerator generator(options.line);
+        out.text("x,y_noisy");
+        out.endRow();
+        double x, y;
+        while (generator.hasNext()) {
+            generator.next(x, y);
+            out.number(x);
+            out.put(',');
+            out.number(y);
+            out.endRow();
+        }
+        return out.flush();
+    }
+
+    vision::BlobGenerator generator(options.blob);
+    const int dims = generator.dims();
+    if (dims == 2) {
+        out.text("x,y,label");
+    } else {
+        for (int d = 0; d < dims; d++) {
+            out.put('x');
+            out.number(d);
+            out.put(',');
+        }
+        out.text("label");
+    }
+    out.endRow();
+
+    std::vector<double> coords(dims);
+    int label;
+    while (generator.hasNext()) {
+        generator.next(coords.data(), label);
+        for (int d = 0; d < dims; d++) {
+            out.number(coords[d]);
+            out.put(',');
+        }
+        out.number(label);
+        out.endRow();
+    }
+    return out.flush();
+}
+
+bool writeBinary(const GenOptions &options)
+{
+    vision::PointStreamHeader header;
+    vision::PointStreamWriter writer;
+
+    if (!options.blobs) {
+        header.columns = 2;
+        header.rows = options.line.rows;
+        if (!writer.open(options.output, header)) return false;
+
+        vision::LineGenerator generator(options.line);
+        double row[2];
+        while (generator.hasNext()) {
+            generator.next(row[0], row[1]);
+            writer.writeRow(row);
+        }
+        return writer.close();
+    }
+
+    vision::BlobGenerator generator(options.blob);
+    const int dims = generator.dims();
+    header.columns = dims + 1;
+    header.flags = vision::PointStreamHasLabel;
+    header.rows = options.blob.rows;
+    if (!writer.open(options.output, header)) return false;
+
+    std::vector<double> row(dims + 1);
+    int label;
+    while (generator.hasNext()) {
+        generator.next(row.data(), label);
+        row[dims] = label;
+        writer.writeRow(row.data());
+    }
+    return writer.close();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    GenOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    bool ok;
+    if (options.format == "bin") {
+        ok = writeBinary(options);
+    } else {
+        std::FILE *file = options.output == "-" ? stdout : std::fopen(options.output.c_str(), "wb");
+        if (!file) {
+            std::cerr << "Cannot open output: " << options.output << '\n';
+            return 1;
+        }
+        ok = writeCsv(options, file);
+        if (file != stdout && std::fclose(file) != 0) ok = false;
+    }
+
+    if (!ok) {
+        std::cerr << "Write failed: " << options.output << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,256 @@
+// Unix 도메인 소켓으로 들어오는 점으로 모델을 계속 갱신한다.
+// 팔로우 모드와 같은 증분 엔진(incremental.h)을 쓰며, 새 프레임의 점만 처리한다.
+//
+// 사용법:
+//   vision_listen [옵션] <소켓 경로>
+//
+//   --algo ransac|lsq|kmeans   갱신할 모델 (기본 lsq)
+//   --threshold <d>            RANSAC inlier 거리 (기본 200)
+//   --k <n>                    k-means 클러스터 수 (기본 3)
+//   --seed <n>                 난수 seed (기본 1)
+//   --report <n>               점이 n 개 들어올 때마다 모델 출력 (기본 1000000, 0이면 끝에만)
+//   --max-points <n>           RANSAC/k-means 가 보관하는 점이 n 개를 넘으면 처음부터 (기본 제한 없음)
+//   --once                     연결 하나만 처리하고 끝냄
+//
+// 보내는 쪽은 vision_send. 연결이 끝날 때마다 처리량과 최종 모델을 출력한다.
+#include "cluster_eval.h"
+#include "incremental.h"
+#include "line_fit.h"
+#include "point_socket.h"
+#include "stats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+enum class Algorithm { Ransac, LeastSquares, KMeans };
+
+struct ListenOptions {
+    Algorithm algorithm = Algorithm::LeastSquares;
+    std::string socketPath;
+    std::size_t report = 1000000;
+    std::size_t maxPoints = 0;
+    bool once = false;
+    vision::RansacParams ransac;
+    vision::KMeansParams kmeans;
+};
+
+void printUsage()
+{
+    std::cerr << "usage: vision_listen [--algo ransac|lsq|kmeans] [--threshold d] [--k n] [--seed n]\n"
+                 "                     [--report n] [--max-points n] [--once] <socket>\n";
+}
+
+bool parseArguments(int argc, char *argv[], ListenOptions &options)
+{
+    options.kmeans.seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char * {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--algo") {
+            const char *v = value();
+            if (!v) return false;
+            if (std::strcmp(v, "ransac") == 0) options.algorithm = Algorithm::Ransac;
+            else if (std::strcmp(v, "lsq") == 0) options.algorithm = Algorithm::LeastSquares;
+            else if (std::strcmp(v, "kmeans") == 0) options.algorithm = Algorithm::KMeans;
+            else return false;
+        } else if (arg == "--threshold") {
+            const char *v = value();
+            if (!v) return false;
+            options.ransac.threshold = std::atof(v);
+        } else if (arg == "--k") {
+            const char *v = value();
+            if (!v) return false;
+            options.kmeans.k = std::atoi(v);
+        } else if (arg == "--seed") {
+            const char *v = value();
+            if (!v) return false;
+            options.ransac.seed = std::strtoull(v, nullptr, 10);
+            options.kmeans.seed = options.ransac.seed;
+        } else if (arg == "--report") {
+            const char *v = value();
+            if (!v) return false;
+            options.report = static_cast<std::size_t>(std::strtoull(v, nullptr, 10));
+        } else if (arg == "--max-points") {
+            const char *v = value();
+            if (!v) return false;
+            options.maxPoints = static_cast<std::size_t>(std::strtoull(v, nullptr, 10));
+        } else if (arg == "--once") {
+            options.once = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            options.socketPath = arg;
+        }
+    }
+    return !options.socketPath.empty();
+}
+
+// 연결 하나의 모델 상태. LSQ 는 합계만 들고 점은 프레임마다 버린다.
+class LiveModel
+{
+public:
+    explicit LiveModel(const ListenOptions &options)
+        : options(options)
+        , ransac(options.ransac)
+        , kmeans(options.kmeans)
+    {
+    }
+
+    void reset()
+    {
+        points.clear();
+        moments = vision::LineMoments();
+        ransac.reset();
+        kmeans.reset();
+    }
+
+    // 새로 받은 점은 points 끝에 있다
+    void update(vision::Stats &stats)
+    {
+        switch (options.algorithm) {
+            case Algorithm::LeastSquares: {
+                VISION_STAT_TIMER(&stats, vision::Stage::LeastSquares);
+                for (std::size_t i = 0; i < points.size(); i++) {
+                    moments.add(points.x[i], points.y[i]);
+                }
+                points.clear();
+                break;
+            }
+            case Algorithm::Ransac:
+                ransac.update(points.view(), &stats);
+                break;
+            case Algorithm::KMeans:
+                kmeans.update(points.view(), &stats);
+                break;
+        }
+        if (options.maxPoints > 0 && points.size() > options.maxPoints) {
+            reset();
+        }
+    }
+
+    void print(std::size_t total) const
+    {
+        switch (options.algorithm) {
+            case Algorithm::LeastSquares: {
+                const vision::LineModel model = moments.solve();
+                std::printf("%zu\tlsq\ta=%.10g\tb=%.10g\n", total, model.a, model.b);
+                break;
+            }
+            case Algorithm::Ransac: {
+                const vision::RansacResult &result = ransac.result();
+                std::printf("%zu\transac\ta=%.10g\tb=%.10g\tinliers=%zu\n", total, result.model.a,
+                            result.model.b, result.inliers.size());
+                break;
+            }
+            case Algorithm::KMeans: {
+                const vision::KMeansResult &result = kmeans.result();
+                std::printf("%zu\tkmeans\twss=%.10g", total, result.wss);
+                for (const vision::Centroid &centroid : result.centroids) {
+                    std::printf("\t(%.6g, %.6g)", centroid.x, centroid.y);
+                }
+                // 라벨이 같이 왔으면 정답과 비교
+                if (points.hasLabels() && result.labels.size() == points.size()) {
+                    const vision::ClusterAgreement agreement =
+                        vision::compareClusterings(points.labels.data(), result.labels.data(), points.size());
+                    std::printf("\tpurity=%.6f\tARI=%.6f", agreement.purity, agreement.adjustedRandIndex);
+                }
+                std::printf("\n");
+                break;
+            }
+        }
+        std::fflush(stdout);
+    }
+
+    vision::PointSet points;
+
+private:
+    const ListenOptions &options;
+    vision::LineMoments moments;
+    vision::IncrementalRansac ransac;
+    vision::IncrementalKMeans kmeans;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    ListenOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    std::string error;
+    vision::PointSocketListener listener;
+    if (!listener.listen(options.socketPath, &error)) {
+        std::cerr << error << '\n';
+        return 1;
+    }
+
+    int status = 0;
+    do {
+        vision::PointSocketReceiver receiver;
+        if (!listener.accept(receiver, &error)) {
+            std::cerr << error << '\n';
+            return 1;
+        }
+
+        LiveModel model(options);
+        vision::Stats stats;
+        std::size_t total = 0;
+        std::size_t nextReport = options.report;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        vision::PointSocketReceiver::Status result;
+        for (;;) {
+            const std::size_t first = model.points.size();
+            {
+                VISION_STAT_TIMER(&stats, vision::Stage::Parse);
+                result = receiver.receive(model.points, &error);
+            }
+            if (result == vision::PointSocketReceiver::Status::Reset) {
+                model.reset();
+                total = 0;
+                nextReport = options.report;
+                continue;
+            }
+            if (result != vision::PointSocketReceiver::Status::Points) {
+                break;
+            }
+
+            // receive 는 점을 뒤에 붙이기만 한다
+            total += model.points.size() - first;
+            model.update(stats);
+
+            if (options.report > 0 && total >= nextReport) {
+                model.print(total);
+                nextReport = total + options.report;
+            }
+        }
+
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        model.print(total);
+        std::fprintf(stderr, "%zu points, %.1f MB in %.3f s (%.2f M points/s)  %s\n", total,
+                     receiver.bytesReceived() / 1e6, seconds,
+                     seconds > 0 ? total / seconds / 1e6 : 0.0, stats.summary().c_str());
+        if (result == vision::PointSocketReceiver::Status::Error) {
+            std::cerr << error << '\n';
+            status = 1;
+        }
+    } while (!options.once);
+
+    return status;
+}
@@ -0,0 +1,166 @@
+// 파일의 점을 Unix 도메인 소켓으로 보낸다 (vision_listen 시험용 로컬 송신기).
+//
+// 사용법:
+//   vision_send [옵션] <소켓 경로> <CSV | .vpts (.gz / .zst 가능)>
+//
+//   --batch <n>          프레임 하나의 점 수 (기본 65536)
+//   --repeat <n>         파일을 n 번 반복해서 보냄 (기본 1)
+//   --label-column <n>   CSV 의 정답 라벨 열 (0부터). 라벨도 같이 보냄
+//   --preload            먼저 전부 읽어 두고 보내기만 측정 (파싱 시간 제외)
+//   --reset              보내기 전에 Reset 프레임을 보냄 (받는 쪽 상태 초기화)
+#include "csv_loader.h"
+#include "point_socket.h"
+#include "point_source.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct SendOptions {
+    std::string socketPath;
+    std::string input;
+    std::size_t batch = 1 << 16;
+    int repeat = 1;
+    int labelColumn = -1;
+    bool preload = false;
+    bool reset = false;
+};
+
+void printUsage()
+{
+    std::cerr << "usage: vision_send [--batch n] [--repeat n] [--label-column n] [--preload] [--reset]\n"
+                 "                   <socket> <file>\n";
+}
+
+bool parseArguments(int argc, char *argv[], SendOptions &options)
+{
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char * {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--batch") {
+            const char *v = value();
+            if (!v) return false;
+            options.batch = static_cast<std::size_t>(std::strtoull(v, nullptr, 10));
+        } else if (arg == "--repeat") {
+            const char *v = value();
+            if (!v) return false;
+            options.repeat = std::atoi(v);
+        } else if (arg == "--label-column") {
+            const char *v = value();
+            if (!v) return false;
+            options.labelColumn = std::atoi(v);
+        } else if (arg == "--preload") {
+            options.preload = true;
+        } else if (arg == "--reset") {
+            options.reset = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() != 2 || options.repeat < 1) {
+        return false;
+    }
+    options.socketPath = positional[0];
+    options.input = positional[1];
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    SendOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    vision::CsvOptions csv;
+    if (options.labelColumn >= 0) {
+        csv.maxColumns = -1;
+        csv.labelColumn = options.labelColumn;
+    }
+
+    std::string error;
+    std::unique_ptr<vision::PointChunkSource> source = vision::openPointSource(options.input, csv, &error);
+    if (!source) {
+        std::cerr << error << '\n';
+        return 1;
+    }
+
+    // --preload: 청크를 모두 읽어 두고 소켓 처리량만 잰다
+    vision::PointSet preloaded;
+    if (options.preload) {
+        vision::PointSet chunk;
+        while (source->next(chunk)) {
+            preloaded.append(chunk);
+        }
+        if (!source->error().empty()) {
+            std::cerr << source->error() << '\n';
+            return 1;
+        }
+    }
+
+    vision::PointSocketSender sender(options.batch);
+    if (!sender.connect(options.socketPath, &error)) {
+        std::cerr << error << '\n';
+        return 1;
+    }
+    if (options.reset && !sender.sendReset()) {
+        std::cerr << sender.error() << '\n';
+        return 1;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::size_t sent = 0;
+    bool ok = true;
+    for (int pass = 0; pass < options.repeat && ok; pass++) {
+        if (options.preload) {
+            ok = sender.send(preloaded.view(), preloaded.hasLabels() ? preloaded.labels.data() : nullptr);
+            sent += preloaded.size();
+            continue;
+        }
+
+        if (pass > 0 && !source->rewind()) {
+            std::cerr << source->error() << '\n';
+            return 1;
+        }
+        vision::PointSet chunk;
+        while (ok && source->next(chunk)) {
+            ok = sender.send(chunk.view(), chunk.hasLabels() ? chunk.labels.data() : nullptr);
+            sent += chunk.size();
+        }
+        if (!source->error().empty()) {
+            std::cerr << source->error() << '\n';
+            return 1;
+        }
+    }
+    ok = ok && sender.flush();
+    const std::uint64_t bytes = sender.bytesSent();
+    sender.close();
+
+    if (!ok) {
+        std::cerr << sender.error() << '\n';
+        return 1;
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%zu points, %.1f MB in %.3f s (%.2f M points/s, %.0f MB/s)\n", sent,
+                 bytes / 1e6, seconds, seconds > 0 ? sent / seconds / 1e6 : 0.0,
+                 seconds > 0 ? bytes / seconds / 1e6 : 0.0);
+    return 0;
+}